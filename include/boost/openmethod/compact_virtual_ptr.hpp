@@ -0,0 +1,222 @@
+// Copyright (c) 2018-2025 Jean-Louis Leroy
+// Distributed under the Boost Software License, Version 1.0.
+// See accompanying file LICENSE_1_0.txt
+// or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_OPENMETHOD_COMPACT_VIRTUAL_PTR_HPP
+#define BOOST_OPENMETHOD_COMPACT_VIRTUAL_PTR_HPP
+
+#include <boost/openmethod/core.hpp>
+
+#include <boost/assert.hpp>
+
+#include <cstddef>
+#include <cstdint>
+
+namespace boost::openmethod {
+
+//! One-word pointer to an object and its v-table.
+//!
+//! `compact_virtual_ptr` stores the address of an object in the low 48 bits of
+//! a word, and the number of its dynamic class in the high 16 bits. It takes
+//! the same space as a plain pointer, which matters for large collections of
+//! pointers to polymorphic objects.
+//!
+//! The class numbers are assigned by @ref initialize, under the @ref
+//! class_intervals policy. The v-table pointer is recovered with a shift and a
+//! load from @ref registry::class_vptrs. Since the pointer does not store the
+//! v-table pointer itself, it remains valid after a new call to `initialize`,
+//! provided that the same classes are registered.
+//!
+//! `compact_virtual_ptr` is a storage format: it converts implicitly to, and
+//! from, @ref virtual_ptr, which is what methods take as arguments. The
+//! conversions follow the same rules as between `virtual_ptr`s.
+//!
+//! @par Requirements
+//!
+//! @li `Registry` must contain the @ref class_intervals policy, and must not
+//! contain @ref indirect_vptr.
+//! @li Pointers must be 64 bits wide, and addresses of objects must fit in 48
+//! bits, as in user space on x86-64 and AArch64. This is checked with
+//! `BOOST_ASSERT`.
+//! @li At most 65536 classes can be registered in `Registry`.
+//!
+//! @tparam Class A registered class, possibly cv-qualified.
+//! @tparam Registry The registry in which `Class` is registered.
+template<class Class, class Registry = BOOST_OPENMETHOD_DEFAULT_REGISTRY>
+class compact_virtual_ptr {
+    static_assert(
+        Registry::has_class_intervals,
+        "compact_virtual_ptr requires the class_intervals policy");
+    static_assert(
+        !Registry::has_indirect_vptr,
+        "compact_virtual_ptr does not support indirect_vptr; it survives "
+        "initialize without it");
+    static_assert(
+        sizeof(void*) == sizeof(std::uint64_t),
+        "compact_virtual_ptr requires 64-bit pointers");
+
+    template<class, class>
+    friend class compact_virtual_ptr;
+
+    static constexpr unsigned address_bits = 48;
+    static constexpr std::uintptr_t address_mask =
+        (std::uintptr_t(1) << address_bits) - 1;
+
+    std::uintptr_t bits;
+
+    static auto pack(const volatile void* obj, vptr_type vptr)
+        -> std::uintptr_t {
+        auto address = reinterpret_cast<std::uintptr_t>(obj);
+        auto number = vptr[detail::class_number].i;
+        BOOST_ASSERT((address & ~address_mask) == 0);
+        BOOST_ASSERT(number >> (64 - address_bits) == 0);
+
+        return address | std::uintptr_t(number) << address_bits;
+    }
+
+  public:
+    //! Class
+    using element_type = Class;
+
+    //! Default constructor
+    //!
+    //! @note This constructor does nothing. The state of the pointer is as
+    //! specified for uninitialized variables by C++.
+    compact_virtual_ptr() = default;
+
+    //! Construct from `nullptr`
+    //!
+    //! @param value A `nullptr`.
+    explicit compact_virtual_ptr(std::nullptr_t) : bits(0) {
+    }
+
+    //! Construct from a reference to an object
+    //!
+    //! The v-table pointer is obtained as for a @ref virtual_ptr.
+    //!
+    //! @param obj A reference to a polymorphic object.
+    template<
+        class Other,
+        typename = std::enable_if_t<
+            std::is_constructible_v<Class*, Other*> &&
+            std::is_polymorphic_v<Other>>>
+    compact_virtual_ptr(Other& obj)
+        : compact_virtual_ptr(virtual_ptr<Class, Registry>(obj)) {
+    }
+
+    //! Construct from a `virtual_ptr`
+    //!
+    //! Makes it possible to initialize a `compact_virtual_ptr` from the result
+    //! of @ref final_virtual_ptr.
+    //!
+    //! @param other A `virtual_ptr` to an object of a class convertible to
+    //! `Class`.
+    template<
+        class Other,
+        typename = std::enable_if_t<std::is_constructible_v<Class*, Other*>>>
+    compact_virtual_ptr(const virtual_ptr<Other, Registry>& other)
+        : bits(
+              other.get() ? pack(static_cast<Class*>(other.get()), other.vptr())
+                          : 0) {
+    }
+
+    //! Construct from a `compact_virtual_ptr` to a convertible class
+    //!
+    //! The class number is copied, the address is adjusted.
+    //!
+    //! @param other A `compact_virtual_ptr` to an object of a class
+    //! convertible to `Class`.
+    template<
+        class Other,
+        typename = std::enable_if_t<std::is_constructible_v<Class*, Other*>>>
+    compact_virtual_ptr(const compact_virtual_ptr<Other, Registry>& other)
+        : bits(
+              other.get() ? reinterpret_cast<std::uintptr_t>(
+                                static_cast<Class*>(other.get())) |
+                      (other.bits & ~address_mask)
+                          : 0) {
+    }
+
+    //! Construct a `compact_virtual_ptr` for an object of a known class
+    //!
+    //! This function forwards to @ref final_virtual_ptr.
+    //!
+    //! @param obj A reference to an object.
+    //! @return A `compact_virtual_ptr<Class, Registry>` pointing to `obj`.
+    template<class Other>
+    static auto final(Other& obj) -> compact_virtual_ptr {
+        return final_virtual_ptr<Registry>(obj);
+    }
+
+    //! Get a pointer to the object
+    //!
+    //! @return A pointer to the object
+    auto get() const -> Class* {
+        return reinterpret_cast<Class*>(bits & address_mask);
+    }
+
+    //! Get a pointer to the object
+    //!
+    //! @return A pointer to the object
+    auto operator->() const -> Class* {
+        return get();
+    }
+
+    //! Get a reference to the object
+    //!
+    //! @return A reference to the object
+    auto operator*() const -> Class& {
+        return *get();
+    }
+
+    //! Get the v-table pointer
+    //!
+    //! @return The v-table pointer; unspecified if the pointer is null.
+    auto vptr() const -> vptr_type {
+        return Registry::class_vptrs[bits >> address_bits];
+    }
+
+    //! Convert to a `virtual_ptr`
+    //!
+    //! @tparam Other A base of `Class`, or `Class` itself.
+    //! @return A `virtual_ptr` to the same object.
+    template<
+        class Other,
+        typename = std::enable_if_t<std::is_constructible_v<Other*, Class*>>>
+    operator virtual_ptr<Other, Registry>() const {
+        if (!bits) {
+            return virtual_ptr<Other, Registry>(nullptr);
+        }
+
+        return virtual_ptr<Other, Registry>(*get(), vptr());
+    }
+};
+
+//! Compare two `compact_virtual_ptr`s for equality.
+//!
+//! @param left A `compact_virtual_ptr`.
+//! @param right A `compact_virtual_ptr`.
+//! @return `true` if both point to the same object, or are both null.
+template<class Left, class Right, class Registry>
+auto operator==(
+    const compact_virtual_ptr<Left, Registry>& left,
+    const compact_virtual_ptr<Right, Registry>& right) -> bool {
+    return left.get() == right.get();
+}
+
+//! Compare two `compact_virtual_ptr`s for inequality.
+//!
+//! @param left A `compact_virtual_ptr`.
+//! @param right A `compact_virtual_ptr`.
+//! @return `true` if they point to different objects.
+template<class Left, class Right, class Registry>
+auto operator!=(
+    const compact_virtual_ptr<Left, Registry>& left,
+    const compact_virtual_ptr<Right, Registry>& right) -> bool {
+    return !(left == right);
+}
+
+} // namespace boost::openmethod
+
+#endif
@@ -8,7 +8,9 @@
 
 #include <stdint.h>
 #include <algorithm>
+#include <cstddef>
 #include <cstdlib>
+#include <memory>
 #include <tuple>
 #include <type_traits>
 #include <utility>
@@ -56,6 +58,15 @@ template<
     typename = detail::sfinae>
 class virtual_ptr;
 
+template<class Class, class Registry>
+class compact_virtual_ptr;
+
+template<class Base, class Registry>
+class segmented_collection;
+
+template<class Class, class Registry>
+class virtual_ptr_vector;
+
 // =============================================================================
 // Helpers
 
@@ -137,11 +148,125 @@ template<class B, class D>
 constexpr bool requires_dynamic_cast =
     detail::requires_dynamic_cast_ref_aux<B, D>::value;
 
+// Under virtual inheritance, the offset between a base and a derived subobject
+// depends only on the dynamic class of the object. Cache the offsets for the
+// classes seen by the calling thread, in a small table indexed by type id, and,
+// on a hit, adjust the address instead of performing a dynamic cast.
+class cast_offset_cache {
+    static constexpr std::size_t size = 8;
+
+    struct entry {
+        bool valid = false;
+        type_id type;
+        std::ptrdiff_t offset;
+    };
+
+    entry entries[size];
+
+    static auto index(type_id type) -> std::size_t {
+        auto bits = reinterpret_cast<std::uintptr_t>(type);
+
+        return (bits ^ (bits >> 4) ^ (bits >> 8)) & (size - 1);
+    }
+
+  public:
+    // Returns a pointer to the offset for `type`, or `nullptr`. Probes
+    // linearly, so up to `size` classes are cached regardless of their ids.
+    auto find(type_id type) const -> const std::ptrdiff_t* {
+        auto first = index(type);
+
+        for (std::size_t i = 0; i < size; ++i) {
+            auto& slot = entries[(first + i) & (size - 1)];
+
+            if (!slot.valid) {
+                break;
+            }
+
+            if (slot.type == type) {
+                return &slot.offset;
+            }
+        }
+
+        return nullptr;
+    }
+
+    // Stores the offset for `type`, which is not in the cache. If the cache is
+    // full, replaces the entry at the home slot of `type`.
+    auto insert(type_id type, std::ptrdiff_t offset) -> void {
+        auto first = index(type);
+        auto* slot = &entries[first];
+
+        for (std::size_t i = 0; i < size; ++i) {
+            auto& candidate = entries[(first + i) & (size - 1)];
+
+            if (!candidate.valid) {
+                slot = &candidate;
+                break;
+            }
+        }
+
+        slot->valid = true;
+        slot->type = type;
+        slot->offset = offset;
+    }
+};
+
+template<class Registry, class D, class B>
+auto cached_dynamic_cast(B&& obj) -> D {
+    static thread_local cast_offset_cache cache;
+
+    auto type = Registry::rtti::dynamic_type(obj);
+    auto base = reinterpret_cast<const volatile char*>(std::addressof(obj));
+
+    if (auto offset = cache.find(type)) {
+        using derived_type = std::remove_reference_t<D>;
+        auto& derived = *reinterpret_cast<derived_type*>(
+            const_cast<char*>(base) + *offset);
+
+        return static_cast<D>(derived);
+    }
+
+    D derived =
+        Registry::rtti::template dynamic_cast_ref<D>(std::forward<B>(obj));
+    cache.insert(
+        type,
+        reinterpret_cast<const volatile char*>(std::addressof(derived)) -
+            base);
+
+    return static_cast<D>(derived);
+}
+
+// Same as cached_dynamic_cast, for pointers. As with `dynamic_cast`, a failed
+// cast yields a null pointer; it is not cached.
+template<class Registry, class D, class B>
+auto cached_dynamic_cast_ptr(B* ptr) -> D {
+    static thread_local cast_offset_cache cache;
+
+    if (!ptr) {
+        return nullptr;
+    }
+
+    auto type = Registry::rtti::dynamic_type(*ptr);
+    auto base = reinterpret_cast<const volatile char*>(ptr);
+
+    if (auto offset = cache.find(type)) {
+        return reinterpret_cast<D>(const_cast<char*>(base) + *offset);
+    }
+
+    auto derived = dynamic_cast<D>(ptr);
+
+    if (derived) {
+        cache.insert(
+            type, reinterpret_cast<const volatile char*>(derived) - base);
+    }
+
+    return derived;
+}
+
 template<class Registry, class D, class B>
 auto optimal_cast(B&& obj) -> decltype(auto) {
     if constexpr (requires_dynamic_cast<B, D>) {
-        return Registry::rtti::template dynamic_cast_ref<D>(
-            std::forward<B>(obj));
+        return cached_dynamic_cast<Registry, D>(std::forward<B>(obj));
     } else {
         return static_cast<D>(obj);
     }
@@ -169,6 +294,20 @@ struct remove_virtual_aux<virtual_<T>> {
 template<typename T>
 using remove_virtual_ = typename remove_virtual_aux<T>::type;
 
+// Non-virtual parameters of class type, passed by value, are passed to the
+// thunks by rvalue reference, and materialized only once, by the overrider.
+template<typename T>
+using thunk_parameter = std::conditional_t<
+    !is_virtual<T>::value && std::is_class_v<T>, T&&, remove_virtual_<T>>;
+
+// Converts an argument to a by-value parameter, or forwards it.
+template<typename T, typename Arg>
+auto thunk_argument(Arg&& arg) -> std::conditional_t<
+    std::is_same_v<thunk_parameter<T>, remove_virtual_<T>>, Arg&&,
+    remove_virtual_<T>> {
+    return std::forward<Arg>(arg);
+}
+
 template<typename T, class Registry, typename = void>
 struct virtual_type_aux {
     using type = void;
@@ -321,17 +460,18 @@ struct virtual_traits<Class*, Registry> {
     //! Cast to another type.
     //!
     //! Cast an object to another type. If possible, use `static_cast`.
-    //! Otherwise, use `Registry::rtti::dynamic_cast_ref`.
+    //! Otherwise, use `dynamic_cast`.
     //!
     //! @tparam Derived A pointer type.
     //! @param obj A pointer to a `Class` object.
-    //! @return A pointer to the same object, cast to `Derived`.
+    //! @return A pointer to the same object, cast to `Derived`, or `nullptr`
+    //! if the cast fails.
     template<typename Derived>
     static auto cast(Class* ptr) -> Derived {
         static_assert(std::is_pointer_v<Derived>);
 
         if constexpr (detail::requires_dynamic_cast<Class*, Derived>) {
-            return dynamic_cast<Derived>(ptr);
+            return detail::cached_dynamic_cast_ptr<Registry, Derived>(ptr);
         } else {
             return static_cast<Derived>(ptr);
         }
@@ -536,6 +676,37 @@ decltype(auto) acquire_vptr(const ArgType& arg) {
     }
 }
 
+template<class VptrFn, class Class, typename = void>
+struct has_dynamic_slot_aux : std::false_type {};
+
+template<class VptrFn, class Class>
+struct has_dynamic_slot_aux<
+    VptrFn, Class,
+    std::void_t<decltype(VptrFn::dynamic_slot(
+        std::declval<const Class&>(), std::size_t()))>> : std::true_type {};
+
+template<class Registry, class Class>
+constexpr bool has_dynamic_slot = has_dynamic_slot_aux<
+    typename Registry::template policy<policies::vptr>, Class>::value;
+
+// Read an entry in the v-table of an object. If the vptr policy can provide
+// v-table entries without going through the v-table pointer (e.g.
+// vptr_prefix_vector), use that.
+template<class Registry, class ArgType>
+BOOST_FORCEINLINE auto acquire_slot(const ArgType& arg, std::size_t slot)
+    -> word {
+    if constexpr (
+        !detail::has_vptr_fn<ArgType, Registry> &&
+        detail::has_dynamic_slot<Registry, ArgType>) {
+        Registry::require_initialized();
+
+        return Registry::template policy<policies::vptr>::dynamic_slot(
+            arg, slot);
+    } else {
+        return acquire_vptr<Registry>(arg)[slot];
+    }
+}
+
 template<bool Indirect>
 inline auto box_vptr(const vptr_type& vp) {
     if constexpr (Indirect) {
@@ -555,6 +726,15 @@ inline auto unbox_vptr(const vptr_type* vpp) {
 
 inline vptr_type null_vptr = nullptr;
 
+// Hint that the object at `p` is about to be accessed.
+inline auto prefetch(const void* p) -> void {
+#if defined(__GNUC__) || defined(__clang__)
+    __builtin_prefetch(p);
+#else
+    (void)p;
+#endif
+}
+
 } // namespace detail
 
 //! Creates a `virtual_ptr` for an object of a known dynamic type.
@@ -672,6 +852,12 @@ class virtual_ptr {
     friend class virtual_ptr;
     template<class, typename Arg>
     friend auto final_virtual_ptr(Arg&& obj);
+    template<class, class>
+    friend class compact_virtual_ptr;
+    template<class, class>
+    friend class segmented_collection;
+    template<class, class>
+    friend class virtual_ptr_vector;
 #endif
 
     static constexpr bool is_smart_ptr = false;
@@ -1925,6 +2111,65 @@ struct virtual_traits<const virtual_ptr<Class, Registry>&, Registry> {
     }
 };
 
+//! Test if an object is an instance of a class, or of one of its subclasses.
+//!
+//! Uses the class numbers that @ref initialize stores in front of the
+//! v-tables, if the registry contains the @ref class_intervals policy. The
+//! test is a range check, or a bit test if multiple inheritance prevents the
+//! subclasses of `Derived` from being numbered contiguously. It takes constant
+//! time, and does not call the @ref rtti policy.
+//!
+//! @tparam Derived A registered class.
+//! @tparam Class A registered class, or a smart pointer to one.
+//! @tparam Registry A @ref registry containing @ref class_intervals.
+//! @param ptr A non-null `virtual_ptr`.
+//! @return `true` if the dynamic class of the object is `Derived`, or one of
+//! its subclasses.
+template<class Derived, class Class, class Registry>
+auto is_a(const virtual_ptr<Class, Registry>& ptr) -> bool {
+    static_assert(
+        Registry::has_class_intervals,
+        "is_a requires the class_intervals policy");
+
+    using namespace detail;
+
+    auto vptr = ptr.vptr();
+    auto derived_vptr =
+        Registry::template static_vptr<std::remove_cv_t<Derived>>;
+    auto number = vptr[class_number].i;
+
+    if (auto bitmap = derived_vptr[class_bitmap].pw) {
+        return bitmap[number / bits_per_word].i >> number % bits_per_word & 1;
+    }
+
+    auto first = derived_vptr[class_number].i;
+
+    return number - first < derived_vptr[class_end].i - first;
+}
+
+//! Cast a `virtual_ptr` to a subclass, if the object is an instance of it.
+//!
+//! Tests the dynamic class of the object with @ref is_a, then casts the
+//! pointer with its `cast` member function. The cast is a static adjustment,
+//! unless `Derived` inherits `Class` virtually.
+//!
+//! @tparam Derived A registered class.
+//! @tparam Class A registered class, or a smart pointer to one.
+//! @tparam Registry A @ref registry containing @ref class_intervals.
+//! @param ptr A `virtual_ptr`.
+//! @return A `virtual_ptr` to the same object, cast to `Derived`, or a null
+//! `virtual_ptr` if `ptr` is null, or does not point to a `Derived`.
+template<class Derived, class Class, class Registry>
+auto fast_cast(const virtual_ptr<Class, Registry>& ptr) {
+    using result_type = decltype(ptr.template cast<Derived>());
+
+    if (!ptr.vptr() || !is_a<Derived>(ptr)) {
+        return result_type(nullptr);
+    }
+
+    return ptr.template cast<Derived>();
+}
+
 // =============================================================================
 // Method
 
@@ -1967,6 +2212,68 @@ using overrider_virtual_types = boost::mp11::mp_remove<
         MethodParameters, OverriderParameters>,
     void>;
 
+// Static class of an argument passed to `call_static`.
+template<typename Arg, class Registry, typename = void>
+struct static_virtual_type_aux {
+    using type = virtual_type<std::remove_reference_t<Arg>&, Registry>;
+};
+
+template<typename Arg, class Registry>
+struct static_virtual_type_aux<
+    Arg, Registry,
+    std::enable_if_t<
+        !std::is_void_v<virtual_type<std::decay_t<Arg>, Registry>>>> {
+    using type = virtual_type<std::decay_t<Arg>, Registry>;
+};
+
+template<typename Parameter, typename Arg, class Registry>
+using select_static_virtual_type = std::conditional_t<
+    is_virtual<Parameter>::value,
+    typename static_virtual_type_aux<Arg, Registry>::type, void>;
+
+// True if each class in `Classes` derives from (or is) the corresponding
+// class in `Bases`.
+template<class Bases, class Classes>
+using all_base_of = boost::mp11::mp_apply<
+    boost::mp11::mp_all,
+    boost::mp11::mp_transform<std::is_base_of, Bases, Classes>>;
+
+template<class Classes>
+struct is_applicable_thunk {
+    template<class Thunk>
+    using fn =
+        all_base_of<typename Thunk::OverriderVirtualParameters, Classes>;
+};
+
+template<class Thunks>
+struct is_dominant_thunk {
+    template<class Other, class Thunk>
+    using dominates = all_base_of<
+        typename Other::OverriderVirtualParameters,
+        typename Thunk::OverriderVirtualParameters>;
+
+    template<class Thunk>
+    using fn = boost::mp11::mp_all_of_q<
+        Thunks, boost::mp11::mp_bind_back<dominates, Thunk>>;
+};
+
+// The thunk of the unique most specialized overrider applicable to `Classes`,
+// if they are all final; `void` otherwise.
+template<class Classes, class Thunks>
+struct static_overrider_aux {
+    using applicable =
+        boost::mp11::mp_filter_q<is_applicable_thunk<Classes>, Thunks>;
+    using dominant =
+        boost::mp11::mp_filter_q<is_dominant_thunk<applicable>, applicable>;
+    using type = boost::mp11::mp_eval_if_c<
+        boost::mp11::mp_size<dominant>::value != 1 ||
+            !boost::mp11::mp_all_of<Classes, std::is_final>::value,
+        void, boost::mp11::mp_front, dominant>;
+};
+
+template<class Classes, class Thunks>
+using static_overrider = typename static_overrider_aux<Classes, Thunks>::type;
+
 template<class Method, class Rtti, std::size_t Index>
 struct init_bad_call {
     template<typename Arg, typename... Args>
@@ -2010,8 +2317,8 @@ struct parameter_traits {
     }
 
     template<typename>
-    static auto cast(T value) -> T {
-        return value;
+    static auto cast(T&& value) -> T&& {
+        return std::forward<T>(value);
     }
 };
 
@@ -2165,6 +2472,9 @@ class method<Id, ReturnType(Parameters...), Registry>
     template<auto Function, typename FunctionType>
     struct override_aux;
 
+    template<class, class>
+    friend class virtual_ptr_vector;
+
     // Aliases used in implementation only. Everything extracted from template
     // arguments is capitalized like the arguments themselves.
     using RegistryType = Registry;
@@ -2177,6 +2487,9 @@ class method<Id, ReturnType(Parameters...), Registry>
     using Signature = auto(Parameters...) -> ReturnType;
     using FunctionPointer = auto (*)(detail::remove_virtual_<Parameters>...)
         -> ReturnType;
+    // The type of the pointers in the dispatch data.
+    using ThunkPointer = auto (*)(detail::thunk_parameter<Parameters>...)
+        -> ReturnType;
 
   public:
     //! Method singleton
@@ -2190,6 +2503,10 @@ class method<Id, ReturnType(Parameters...), Registry>
     //! Call the method with `args`. The types of the arguments are the same as
     //! the method `Parameters...`, stripped from any `virtual\_` decorators.
     //!
+    //! If all the calls resolve to the same overrider, and `Registry` contains
+    //! neither a @ref runtime_checks nor a @ref profiler policy, the overrider
+    //! is called directly, without acquiring v-table pointers.
+    //!
     //! @param args The arguments for the method call
     //!
     //! @par Errors
@@ -2205,6 +2522,79 @@ class method<Id, ReturnType(Parameters...), Registry>
                         StripVirtualDecorator<Parameters>::type... args) const
         -> ReturnType;
 
+    //! Call the method, selecting the overrider at compile time
+    //!
+    //! If the static types of all the virtual arguments are `final` classes,
+    //! select the most specialized overrider among `Fn...` at compile time,
+    //! and call it directly, which allows it to be inlined. Otherwise, or if
+    //! `Fn...` does not contain a unique most specialized overrider for the
+    //! arguments, call the method normally.
+    //!
+    //! The selection is checked against the dispatch tables, and, if they
+    //! select a different overrider - for example, a more specialized one
+    //! that is defined in another translation unit - it is called instead.
+    //! The selected overrider is still called directly, and can be inlined.
+    //!
+    //! @tparam Fn Zero or more overriders of the method.
+    //! @tparam Args The types of the arguments, deduced.
+    //! @param args The arguments for the method call.
+    template<auto... Fn, typename... Args>
+    auto call_static(Args&&... args) const -> ReturnType;
+
+    //! Call the method, selecting the overrider at compile time, unchecked
+    //!
+    //! Same as @ref call_static, except that the selection is not checked
+    //! against the dispatch tables, so the call does not acquire v-table
+    //! pointers at all. `Fn...` must contain all the overriders of the method
+    //! that may be selected for the arguments, in any translation unit;
+    //! otherwise, a less specialized overrider is called.
+    //!
+    //! @tparam Fn Zero or more overriders of the method.
+    //! @tparam Args The types of the arguments, deduced.
+    //! @param args The arguments for the method call.
+    template<auto... Fn, typename... Args>
+    auto call_static_unchecked(Args&&... args) const -> ReturnType;
+
+    //! Call the method, without an indirect call to known overriders
+    //!
+    //! Resolve the call as `operator()` does, then compare the selected
+    //! overrider with `Fn...`, in order, and call the first match directly.
+    //! Only overriders that are not in `Fn...` are called indirectly. This is
+    //! useful in builds hardened against speculative execution attacks (for
+    //! example with retpolines or control-flow enforcement), which make
+    //! indirect calls expensive. List the most frequently called overriders
+    //! first.
+    //!
+    //! @tparam Fn Zero or more overriders of the method.
+    //! @param args The arguments for the method call.
+    template<auto... Fn>
+    auto call_direct(typename BOOST_OPENMETHOD_DETAIL_UNLESS_MRDOCS
+                         StripVirtualDecorator<Parameters>::type... args) const
+        -> ReturnType;
+
+    //! Call the method for each object in a range of objects of the same class
+    //!
+    //! Call the method once for each element in [`first`, `last`), passed as
+    //! the first argument, followed by `more`. The call is resolved only once,
+    //! for the first element, and the selected overrider is called directly
+    //! for the others. Elements can be references to objects, or @ref
+    //! virtual_ptr{empty}s; the latter are dereferenced if the first parameter
+    //! is not a `virtual_ptr`.
+    //!
+    //! @par Requirements
+    //!
+    //! @li The first parameter of the method must be virtual.
+    //! @li All the elements in the range must have the same dynamic class.
+    //!
+    //! @tparam Iterator An input iterator.
+    //! @tparam MoreArgs The types of the remaining arguments, deduced.
+    //! @param first The beginning of the range.
+    //! @param last The end of the range.
+    //! @param more The remaining arguments, passed as lvalues to each call.
+    template<class Iterator, typename... MoreArgs>
+    auto for_each(Iterator first, Iterator last, MoreArgs&&... more) const
+        -> void;
+
     //! Check if a next most specialized overrider exists
     //!
     //! Return `true` if a next most specialized overrider after _Fn_ exists,
@@ -2289,7 +2679,10 @@ class method<Id, ReturnType(Parameters...), Registry>
     void resolve_type_ids();
 
     template<typename ArgType>
-    auto vptr(const ArgType& arg) const -> vptr_type;
+    auto slot(const ArgType& arg, std::size_t slot) const -> detail::word;
+
+    template<std::size_t VirtualArg, typename ArgType>
+    auto record(const ArgType& arg) const -> void;
 
     template<typename MethodArgList, typename ArgType, typename... MoreArgTypes>
     auto resolve_uni(const ArgType& arg, const MoreArgTypes&... more_args) const
@@ -2308,7 +2701,34 @@ class method<Id, ReturnType(Parameters...), Registry>
         const MoreArgTypes&... more_args) const -> detail::word;
 
     template<typename... ArgType>
-    FunctionPointer resolve(const ArgType&... args) const;
+    ThunkPointer resolve(const ArgType&... args) const;
+
+    template<class Thunk>
+    static auto call_checked(detail::thunk_parameter<Parameters>... args)
+        -> ReturnType;
+
+    template<typename... Args>
+    static auto call_direct_aux(
+        mp11::mp_list<>, ThunkPointer pf, Args&&... args) -> ReturnType;
+
+    template<class Thunk, class... MoreThunks, typename... Args>
+    static auto call_direct_aux(
+        mp11::mp_list<Thunk, MoreThunks...>, ThunkPointer pf,
+        Args&&... args) -> ReturnType;
+
+    template<
+        typename First, typename... MoreParameters, class Iterator,
+        typename... MoreArgs>
+    auto for_each_aux(
+        mp11::mp_list<First, MoreParameters...>, Iterator first,
+        Iterator last, MoreArgs&... more) const -> void;
+
+    template<
+        typename First, typename... MoreParameters, class Element,
+        typename... MoreArgs>
+    auto for_each_batched(
+        mp11::mp_list<First, MoreParameters...>, std::size_t size,
+        const Element& element, MoreArgs&... more) const -> void;
 
     template<auto, typename>
     struct thunk;
@@ -2327,13 +2747,20 @@ class method<Id, ReturnType(Parameters...), Registry>
         detail::remove_virtual_<Parameters>... args) -> ReturnType;
     static BOOST_NORETURN auto
     fn_ambiguous(detail::remove_virtual_<Parameters>... args) -> ReturnType;
+    static BOOST_NORETURN auto thunk_not_implemented(
+        detail::thunk_parameter<Parameters>... args) -> ReturnType;
+    static BOOST_NORETURN auto
+    thunk_ambiguous(detail::thunk_parameter<Parameters>... args) -> ReturnType;
 
     template<
         auto Overrider, typename OverriderReturn,
         typename... OverriderParameters>
     struct thunk<Overrider, OverriderReturn (*)(OverriderParameters...)> {
         static auto
-        fn(detail::remove_virtual_<Parameters>... arg) -> ReturnType;
+        fn(detail::thunk_parameter<Parameters>... arg) -> ReturnType;
+        // Same, with the signature of `next` pointers.
+        static auto
+        next_fn(detail::remove_virtual_<Parameters>... arg) -> ReturnType;
         using OverriderVirtualParameters = detail::overrider_virtual_types<
             DeclaredParameters, mp11::mp_list<OverriderParameters...>,
             Registry>;
@@ -2401,8 +2828,12 @@ method<Id, ReturnType(Parameters...), Registry>::method() {
 
     this->vp_begin = vp_type_ids;
     this->vp_end = vp_type_ids + Arity;
-    this->not_implemented = reinterpret_cast<void (*)()>(fn_not_implemented);
-    this->ambiguous = reinterpret_cast<void (*)()>(fn_ambiguous);
+    this->not_implemented =
+        reinterpret_cast<void (*)()>(thunk_not_implemented);
+    this->ambiguous = reinterpret_cast<void (*)()>(thunk_ambiguous);
+    this->next_not_implemented =
+        reinterpret_cast<void (*)()>(fn_not_implemented);
+    this->next_ambiguous = reinterpret_cast<void (*)()>(fn_ambiguous);
 
     // zero-initalized static variable
     // coverity[uninit_use]
@@ -2445,17 +2876,231 @@ method<Id, ReturnType(Parameters...), Registry>::operator()(
         args)...);
 }
 
+template<
+    typename Id, typename... Parameters, typename ReturnType, class Registry>
+template<auto... Fn, typename... Args>
+BOOST_FORCEINLINE auto
+method<Id, ReturnType(Parameters...), Registry>::call_static(
+    Args&&... args) const -> ReturnType {
+    static_assert(
+        sizeof...(Args) == sizeof...(Parameters), "wrong number of arguments");
+
+    using Classes = mp11::mp_remove<
+        mp11::mp_list<
+            detail::select_static_virtual_type<Parameters, Args, Registry>...>,
+        void>;
+    using Thunk = detail::static_overrider<
+        Classes, mp11::mp_list<thunk<Fn, decltype(Fn)>...>>;
+
+    if constexpr (std::is_void_v<Thunk>) {
+        return (*this)(std::forward<Args>(args)...);
+    } else {
+        return call_checked<Thunk>(
+            detail::thunk_argument<Parameters>(std::forward<Args>(args))...);
+    }
+}
+
+template<
+    typename Id, typename... Parameters, typename ReturnType, class Registry>
+template<auto... Fn, typename... Args>
+BOOST_FORCEINLINE auto
+method<Id, ReturnType(Parameters...), Registry>::call_static_unchecked(
+    Args&&... args) const -> ReturnType {
+    static_assert(
+        sizeof...(Args) == sizeof...(Parameters), "wrong number of arguments");
+
+    using Classes = mp11::mp_remove<
+        mp11::mp_list<
+            detail::select_static_virtual_type<Parameters, Args, Registry>...>,
+        void>;
+    using Thunk = detail::static_overrider<
+        Classes, mp11::mp_list<thunk<Fn, decltype(Fn)>...>>;
+
+    if constexpr (std::is_void_v<Thunk>) {
+        return (*this)(std::forward<Args>(args)...);
+    } else {
+        return Thunk::fn(
+            detail::thunk_argument<Parameters>(std::forward<Args>(args))...);
+    }
+}
+
+template<
+    typename Id, typename... Parameters, typename ReturnType, class Registry>
+template<class Thunk>
+auto method<Id, ReturnType(Parameters...), Registry>::call_checked(
+    detail::thunk_parameter<Parameters>... args) -> ReturnType {
+    using namespace detail;
+    auto pf =
+        fn.resolve(parameter_traits<Parameters, Registry>::peek(args)...);
+
+    if (pf == Thunk::fn) {
+        return Thunk::fn(std::forward<thunk_parameter<Parameters>>(args)...);
+    }
+
+    return pf(std::forward<thunk_parameter<Parameters>>(args)...);
+}
+
+template<
+    typename Id, typename... Parameters, typename ReturnType, class Registry>
+template<auto... Fn>
+BOOST_FORCEINLINE auto
+method<Id, ReturnType(Parameters...), Registry>::call_direct(
+    typename BOOST_OPENMETHOD_DETAIL_UNLESS_MRDOCS
+        StripVirtualDecorator<Parameters>::type... args) const -> ReturnType {
+    using namespace detail;
+    auto pf = resolve(parameter_traits<Parameters, Registry>::peek(args)...);
+
+    return call_direct_aux(
+        mp11::mp_list<thunk<Fn, decltype(Fn)>...>(), pf,
+        std::forward<typename StripVirtualDecorator<Parameters>::type>(
+            args)...);
+}
+
+template<
+    typename Id, typename... Parameters, typename ReturnType, class Registry>
+template<typename... Args>
+BOOST_FORCEINLINE auto
+method<Id, ReturnType(Parameters...), Registry>::call_direct_aux(
+    mp11::mp_list<>, ThunkPointer pf, Args&&... args) -> ReturnType {
+    return pf(std::forward<Args>(args)...);
+}
+
+template<
+    typename Id, typename... Parameters, typename ReturnType, class Registry>
+template<class Thunk, class... MoreThunks, typename... Args>
+BOOST_FORCEINLINE auto
+method<Id, ReturnType(Parameters...), Registry>::call_direct_aux(
+    mp11::mp_list<Thunk, MoreThunks...>, ThunkPointer pf,
+    Args&&... args) -> ReturnType {
+    if (pf == Thunk::fn) {
+        return Thunk::fn(std::forward<Args>(args)...);
+    }
+
+    return call_direct_aux(
+        mp11::mp_list<MoreThunks...>(), pf, std::forward<Args>(args)...);
+}
+
+template<
+    typename Id, typename... Parameters, typename ReturnType, class Registry>
+template<class Iterator, typename... MoreArgs>
+auto method<Id, ReturnType(Parameters...), Registry>::for_each(
+    Iterator first, Iterator last, MoreArgs&&... more) const -> void {
+    static_assert(
+        sizeof...(MoreArgs) + 1 == sizeof...(Parameters),
+        "wrong number of arguments");
+    static_assert(
+        detail::is_virtual<mp11::mp_first<DeclaredParameters>>::value,
+        "the first parameter must be virtual");
+
+    for_each_aux(DeclaredParameters(), first, last, more...);
+}
+
+template<
+    typename Id, typename... Parameters, typename ReturnType, class Registry>
+template<
+    typename First, typename... MoreParameters, class Iterator,
+    typename... MoreArgs>
+auto method<Id, ReturnType(Parameters...), Registry>::for_each_aux(
+    mp11::mp_list<First, MoreParameters...>, Iterator first, Iterator last,
+    MoreArgs&... more) const -> void {
+    using namespace detail;
+    using FirstArg = typename StripVirtualDecorator<First>::type;
+    // Elements may be temporaries: hold `virtual_ptr`s by value.
+    using FirstArgHolder = std::conditional_t<
+        is_virtual_ptr<FirstArg>, std::decay_t<FirstArg>, FirstArg>;
+
+    auto element = [](auto&& elem) -> decltype(auto) {
+        using Element = decltype(elem);
+
+        if constexpr (
+            is_virtual_ptr<FirstArg> ||
+            !is_virtual_ptr<std::decay_t<Element>>) {
+            return std::forward<Element>(elem);
+        } else {
+            return *elem;
+        }
+    };
+
+    if (first == last) {
+        return;
+    }
+
+    ThunkPointer pf;
+
+    {
+        FirstArgHolder arg = element(*first);
+        pf = resolve(
+            parameter_traits<First, Registry>::peek(arg),
+            parameter_traits<MoreParameters, Registry>::peek(more)...);
+    }
+
+    for (; first != last; ++first) {
+        FirstArgHolder arg = element(*first);
+        pf(std::forward<FirstArg>(arg),
+           thunk_argument<MoreParameters>(more)...);
+    }
+}
+
+// Call the method for `size` `virtual_ptr`s, returned by `element(i)`. For
+// each batch of elements, first resolve all the calls, reading the slots from
+// the v-tables, and prefetch the objects; then call the overriders.
+template<
+    typename Id, typename... Parameters, typename ReturnType, class Registry>
+template<
+    typename First, typename... MoreParameters, class Element,
+    typename... MoreArgs>
+auto method<Id, ReturnType(Parameters...), Registry>::for_each_batched(
+    mp11::mp_list<First, MoreParameters...>, std::size_t size,
+    const Element& element, MoreArgs&... more) const -> void {
+    using namespace detail;
+    using FirstArg = typename StripVirtualDecorator<First>::type;
+    using FirstArgHolder = std::decay_t<FirstArg>;
+
+    static_assert(
+        is_virtual_ptr<FirstArg>,
+        "the first parameter must be a virtual_ptr");
+
+    constexpr std::size_t batch_size = 16;
+    ThunkPointer pfs[batch_size];
+
+    for (std::size_t start = 0; start < size; start += batch_size) {
+        auto count = size - start < batch_size ? size - start : batch_size;
+
+        for (std::size_t i = 0; i < count; ++i) {
+            FirstArgHolder arg = element(start + i);
+            prefetch(arg.get());
+            pfs[i] = resolve(
+                parameter_traits<First, Registry>::peek(arg),
+                parameter_traits<MoreParameters, Registry>::peek(more)...);
+        }
+
+        for (std::size_t i = 0; i < count; ++i) {
+            FirstArgHolder arg = element(start + i);
+            pfs[i](
+                std::forward<FirstArg>(arg),
+                thunk_argument<MoreParameters>(more)...);
+        }
+    }
+}
+
 template<
     typename Id, typename... Parameters, typename ReturnType, class Registry>
 template<typename... ArgType>
 BOOST_FORCEINLINE
-    typename method<Id, ReturnType(Parameters...), Registry>::FunctionPointer
+    typename method<Id, ReturnType(Parameters...), Registry>::ThunkPointer
     method<Id, ReturnType(Parameters...), Registry>::resolve(
         const ArgType&... args) const {
     using namespace detail;
 
     Registry::require_initialized();
 
+    if constexpr (!Registry::has_runtime_checks && !Registry::has_profiler) {
+        // All the calls go to the same overrider: skip vptr acquisition.
+        if (this->monomorphic) {
+            return reinterpret_cast<ThunkPointer>(this->monomorphic);
+        }
+    }
+
     void (*pf)();
 
     if constexpr (Arity == 1) {
@@ -2466,18 +3111,38 @@ BOOST_FORCEINLINE
                  .pf;
     }
 
-    return reinterpret_cast<FunctionPointer>(pf);
+    return reinterpret_cast<ThunkPointer>(pf);
 }
 
 template<
     typename Id, typename... Parameters, typename ReturnType, class Registry>
 template<typename ArgType>
-BOOST_FORCEINLINE auto method<Id, ReturnType(Parameters...), Registry>::vptr(
-    const ArgType& arg) const -> vptr_type {
+BOOST_FORCEINLINE auto method<Id, ReturnType(Parameters...), Registry>::slot(
+    const ArgType& arg, std::size_t slot) const -> detail::word {
     if constexpr (detail::is_virtual_ptr<ArgType>) {
-        return arg.vptr();
+        return arg.vptr()[slot];
     } else {
-        return detail::acquire_vptr<Registry>(arg);
+        return detail::acquire_slot<Registry>(arg, slot);
+    }
+}
+
+template<
+    typename Id, typename... Parameters, typename ReturnType, class Registry>
+template<std::size_t VirtualArg, typename ArgType>
+BOOST_FORCEINLINE auto method<Id, ReturnType(Parameters...), Registry>::record(
+    const ArgType& arg) const -> void {
+    if constexpr (Registry::has_profiler) {
+        vptr_type vptr;
+
+        if constexpr (detail::is_virtual_ptr<ArgType>) {
+            vptr = arg.vptr();
+        } else {
+            vptr = detail::acquire_vptr<Registry>(arg);
+        }
+
+        Registry::profiler::record(*this, VirtualArg, vptr);
+    } else {
+        (void)arg;
     }
 }
 
@@ -2494,8 +3159,9 @@ method<Id, ReturnType(Parameters...), Registry>::resolve_uni(
     using namespace boost::mp11;
 
     if constexpr (is_virtual<mp_first<MethodArgList>>::value) {
-        vptr_type vtbl = vptr<ArgType>(arg);
-        return vtbl[this->slots_strides[0]];
+        record<0>(arg);
+
+        return slot<ArgType>(arg, this->slots_strides[0]);
     } else {
         return resolve_uni<mp_rest<MethodArgList>>(more_args...);
     }
@@ -2513,14 +3179,12 @@ method<Id, ReturnType(Parameters...), Registry>::resolve_multi_first(
     using namespace boost::mp11;
 
     if constexpr (is_virtual<mp_first<MethodArgList>>::value) {
-        vptr_type vtbl = vptr<ArgType>(arg);
-        std::size_t slot = this->slots_strides[0];
-
         // The first virtual parameter is special.  Since its stride is
         // 1, there is no need to store it. Also, the method table
         // contains a pointer into the multi-dimensional dispatch table,
         // already resolved to the appropriate group.
-        auto dispatch = vtbl[slot].pw;
+        record<0>(arg);
+        auto dispatch = slot<ArgType>(arg, this->slots_strides[0]).pw;
         return resolve_multi_next<1, mp_rest<MethodArgList>, MoreArgTypes...>(
             dispatch, more_args...);
     } else {
@@ -2543,10 +3207,10 @@ method<Id, ReturnType(Parameters...), Registry>::resolve_multi_next(
     using namespace boost::mp11;
 
     if constexpr (is_virtual<mp_first<MethodArgList>>::value) {
-        vptr_type vtbl = vptr<ArgType>(arg);
-        std::size_t slot = this->slots_strides[VirtualArg];
+        record<VirtualArg>(arg);
         std::size_t stride = this->slots_strides[Arity + VirtualArg - 1];
-        dispatch = dispatch + vtbl[slot].i * stride;
+        dispatch = dispatch +
+            slot<ArgType>(arg, this->slots_strides[VirtualArg]).i * stride;
     }
 
     if constexpr (VirtualArg + 1 == Arity) {
@@ -2613,6 +3277,23 @@ method<Id, ReturnType(Parameters...), Registry>::fn_ambiguous(
     abort(); // in case user handler "forgets" to abort
 }
 
+template<
+    typename Id, typename... Parameters, typename ReturnType, class Registry>
+BOOST_NORETURN auto
+method<Id, ReturnType(Parameters...), Registry>::thunk_not_implemented(
+    detail::thunk_parameter<Parameters>... args) -> ReturnType {
+    fn_not_implemented(
+        std::forward<detail::thunk_parameter<Parameters>>(args)...);
+}
+
+template<
+    typename Id, typename... Parameters, typename ReturnType, class Registry>
+BOOST_NORETURN auto
+method<Id, ReturnType(Parameters...), Registry>::thunk_ambiguous(
+    detail::thunk_parameter<Parameters>... args) -> ReturnType {
+    fn_ambiguous(std::forward<detail::thunk_parameter<Parameters>>(args)...);
+}
+
 // -----------------------------------------------------------------------------
 // overriders
 
@@ -2715,7 +3396,7 @@ template<
     auto Overrider, typename OverriderReturn, typename... OverriderParameters>
 auto method<Id, ReturnType(Parameters...), Registry>::
     thunk<Overrider, OverriderReturn (*)(OverriderParameters...)>::fn(
-        detail::remove_virtual_<Parameters>... arg) -> ReturnType {
+        detail::thunk_parameter<Parameters>... arg) -> ReturnType {
     using namespace detail;
     static_assert(
         (validate_overrider_parameter<Parameters, OverriderParameters>::value &&
@@ -2724,7 +3405,17 @@ auto method<Id, ReturnType(Parameters...), Registry>::
     return Overrider(
         detail::parameter_traits<Parameters, Registry>::template cast<
             OverriderParameters>(
-            std::forward<detail::remove_virtual_<Parameters>>(arg))...);
+            std::forward<detail::thunk_parameter<Parameters>>(arg))...);
+}
+
+template<
+    typename Id, typename... Parameters, typename ReturnType, class Registry>
+template<
+    auto Overrider, typename OverriderReturn, typename... OverriderParameters>
+auto method<Id, ReturnType(Parameters...), Registry>::
+    thunk<Overrider, OverriderReturn (*)(OverriderParameters...)>::next_fn(
+        detail::remove_virtual_<Parameters>... arg) -> ReturnType {
+    return fn(std::forward<detail::remove_virtual_<Parameters>>(arg)...);
 }
 
 template<
@@ -2774,6 +3465,7 @@ method<Id, ReturnType(Parameters...), Registry>::override_impl<
 
     using Thunk = thunk<Function, decltype(Function)>;
     this->pf = reinterpret_cast<void (*)()>(Thunk::fn);
+    this->next_pf = reinterpret_cast<void (*)()>(Thunk::next_fn);
 
     this->vp_begin = vp_type_ids;
     this->vp_end = vp_type_ids + Arity;
@@ -0,0 +1,40 @@
+// Copyright (c) 2018-2025 Jean-Louis Leroy
+// Distributed under the Boost Software License, Version 1.0.
+// See accompanying file LICENSE_1_0.txt
+// or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_OPENMETHOD_DETAIL_ALLOCATOR_HPP
+#define BOOST_OPENMETHOD_DETAIL_ALLOCATOR_HPP
+
+#include <cstddef>
+#include <type_traits>
+
+#if __has_include(<memory_resource>)
+#include <memory_resource>
+#define BOOST_OPENMETHOD_DETAIL_HAS_MEMORY_RESOURCE
+#endif
+
+namespace boost::openmethod {
+
+namespace detail {
+
+// Return `alloc`, or a `std::pmr::polymorphic_allocator` if `alloc` is a
+// pointer to a `std::pmr::memory_resource`.
+template<class Allocator>
+auto as_allocator(const Allocator& alloc) {
+#ifdef BOOST_OPENMETHOD_DETAIL_HAS_MEMORY_RESOURCE
+    if constexpr (std::is_convertible_v<
+                      Allocator, std::pmr::memory_resource*>) {
+        return std::pmr::polymorphic_allocator<std::byte>(alloc);
+    } else {
+        return alloc;
+    }
+#else
+    return alloc;
+#endif
+}
+
+} // namespace detail
+} // namespace boost::openmethod
+
+#endif
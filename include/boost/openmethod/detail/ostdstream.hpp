@@ -10,6 +10,7 @@
 #include <cstdio>
 #include <charconv>
 #include <random>
+#include <string>
 #include <string_view>
 
 namespace boost::openmethod {
@@ -99,6 +100,56 @@ inline auto operator<<(ostdstream& os, std::size_t value) -> ostdstream& {
     return os;
 }
 
+// -----------------------------------------------------------------------------
+// lightweight string stream
+
+struct ostrstream {
+    std::string str;
+};
+
+inline auto
+operator<<(ostrstream& os, const std::string_view& view) -> ostrstream& {
+    os.str.append(view.data(), view.length());
+
+    return os;
+}
+
+inline auto operator<<(ostrstream& os, const char* str) -> ostrstream& {
+    return os << std::string_view(str);
+}
+
+inline auto operator<<(ostrstream& os, const void* value) -> ostrstream& {
+    std::array<char, 20> str;
+    auto end = std::to_chars(
+                   str.data(), str.data() + str.size(),
+                   reinterpret_cast<uintptr_t>(value), 16)
+                   .ptr;
+
+    return os << std::string_view(str.data(), end - str.data());
+}
+
+inline auto operator<<(ostrstream& os, std::size_t value) -> ostrstream& {
+    std::array<char, 20> str;
+    auto end = std::to_chars(str.data(), str.data() + str.size(), value).ptr;
+
+    return os << std::string_view(str.data(), end - str.data());
+}
+
+// -----------------------------------------------------------------------------
+// line input
+
+// Read a line, without the terminating newline. Return `false` at end of file.
+inline auto read_line(FILE* file, std::string& line) -> bool {
+    line.clear();
+    int c;
+
+    while ((c = getc(file)) != EOF && c != '\n') {
+        line += char(c);
+    }
+
+    return c != EOF || !line.empty();
+}
+
 } // namespace detail
 
 } // namespace boost::openmethod
@@ -0,0 +1,275 @@
+// Copyright (c) 2018-2025 Jean-Louis Leroy
+// Distributed under the Boost Software License, Version 1.0.
+// See accompanying file LICENSE_1_0.txt
+// or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_OPENMETHOD_HEADER_VPTR_HPP
+#define BOOST_OPENMETHOD_HEADER_VPTR_HPP
+
+#include <boost/openmethod/core.hpp>
+#include <boost/openmethod/policies/header_vptr.hpp>
+
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <utility>
+
+namespace boost::openmethod {
+
+//! Allocates objects with a hidden v-table pointer header.
+//!
+//! `header_vptr_allocator` adapts an allocator to create objects preceded by
+//! a header that contains the address of the @ref registry::static_vptr of
+//! their class. The @ref header_vptr policy reads the v-table pointer from
+//! the header, without using RTTI.
+//!
+//! Objects created by `new_object` must be destroyed by `delete_object`, via a
+//! pointer to their class, or to a base class with a virtual destructor.
+//!
+//! @tparam Registry The registry in which the classes are registered.
+//! @tparam Allocator An allocator. It is rebound to an internal type, aligned
+//! on `__STDCPP_DEFAULT_NEW_ALIGNMENT__`.
+template<
+    class Registry = BOOST_OPENMETHOD_DEFAULT_REGISTRY,
+    class Allocator = std::allocator<std::byte>>
+class header_vptr_allocator {
+    using unit_allocator = typename std::allocator_traits<
+        Allocator>::template rebind_alloc<detail::vptr_header_unit>;
+    using traits = std::allocator_traits<unit_allocator>;
+
+    template<class, class>
+    friend class header_vptr_allocator;
+
+    unit_allocator alloc;
+
+  public:
+    //! The adapted allocator.
+    using allocator_type = Allocator;
+
+    //! Default constructor.
+    header_vptr_allocator() = default;
+
+    //! Construct from an allocator.
+    //!
+    //! @param alloc The allocator to adapt.
+    explicit header_vptr_allocator(const Allocator& alloc) : alloc(alloc) {
+    }
+
+    //! Create an object with a header.
+    //!
+    //! Allocate a block large enough for a header and an object of type
+    //! `Class`, construct the object with `args`, and record its class in the
+    //! header.
+    //!
+    //! @tparam Class The class of the object to create.
+    //! @tparam T Types of the arguments to pass to the constructor of `Class`.
+    //! @param args Arguments to pass to the constructor of `Class`.
+    //! @return A pointer to the new object.
+    template<class Class, typename... T>
+    auto new_object(T&&... args) -> Class* {
+        static_assert(
+            alignof(Class) <= alignof(detail::vptr_header_unit),
+            "over-aligned classes are not supported");
+
+        constexpr auto units =
+            (detail::vptr_header_size + sizeof(Class) +
+             sizeof(detail::vptr_header_unit) - 1) /
+            sizeof(detail::vptr_header_unit);
+
+        auto block = reinterpret_cast<char*>(
+            std::addressof(*traits::allocate(alloc, units)));
+        auto obj = block + detail::vptr_header_size;
+        Class* result;
+
+        try {
+            result = ::new (static_cast<void*>(obj))
+                Class(std::forward<T>(args)...);
+        } catch (...) {
+            traits::deallocate(
+                alloc, reinterpret_cast<detail::vptr_header_unit*>(block),
+                units);
+            throw;
+        }
+
+        auto header = ::new (static_cast<void*>(
+            obj - sizeof(detail::vptr_header))) detail::vptr_header;
+        header->size = units;
+        header->tag = detail::vptr_header_tag(obj);
+        header->vptr = &Registry::template static_vptr<Class>;
+
+        return result;
+    }
+
+    //! Destroy an object created by `new_object`.
+    //!
+    //! Destroy the object, erase its header, and deallocate the block.
+    //!
+    //! @tparam Class The class of the object, or a base class with a virtual
+    //! destructor.
+    //! @param obj A pointer to the object, or `nullptr`.
+    template<class Class>
+    auto delete_object(Class* obj) -> void {
+        if (!obj) {
+            return;
+        }
+
+        auto complete = const_cast<char*>(static_cast<const char*>(
+            detail::vptr_header_object(*obj)));
+        auto header = reinterpret_cast<detail::vptr_header*>(complete) - 1;
+        auto units = header->size;
+        header->tag = 0;
+        obj->~Class();
+        traits::deallocate(
+            alloc,
+            reinterpret_cast<detail::vptr_header_unit*>(
+                complete - detail::vptr_header_size),
+            units);
+    }
+
+    //! Return a copy of the adapted allocator.
+    auto get_allocator() const -> Allocator {
+        return Allocator(alloc);
+    }
+};
+
+//! Deleter for objects created by a @ref header_vptr_allocator.
+//!
+//! Like `std::default_delete`, a `header_vptr_deleter` for a class converts
+//! to a `header_vptr_deleter` for its base classes. This makes it possible to
+//! convert between `std::unique_ptr`s.
+//!
+//! @tparam Class The class of the objects to delete.
+//! @tparam Registry The registry in which the classes are registered.
+//! @tparam Allocator The allocator used to create the objects.
+template<
+    class Class, class Registry = BOOST_OPENMETHOD_DEFAULT_REGISTRY,
+    class Allocator = std::allocator<std::byte>>
+class header_vptr_deleter {
+    template<class, class, class>
+    friend class header_vptr_deleter;
+
+    header_vptr_allocator<Registry, Allocator> alloc;
+
+  public:
+    //! Default constructor.
+    header_vptr_deleter() = default;
+
+    //! Construct from an allocator.
+    //!
+    //! @param alloc The allocator used to create the objects.
+    explicit header_vptr_deleter(
+        const header_vptr_allocator<Registry, Allocator>& alloc)
+        : alloc(alloc) {
+    }
+
+    //! Construct from a deleter for a derived class.
+    //!
+    //! @param other A `header_vptr_deleter` for a class convertible to
+    //! `Class`.
+    template<
+        class Other,
+        typename = std::enable_if_t<std::is_convertible_v<Other*, Class*>>>
+    header_vptr_deleter(
+        const header_vptr_deleter<Other, Registry, Allocator>& other)
+        : alloc(other.alloc) {
+    }
+
+    //! Destroy an object and deallocate its block.
+    //!
+    //! @param obj A pointer to the object.
+    auto operator()(Class* obj) -> void {
+        alloc.delete_object(obj);
+    }
+};
+
+//! Alias for a `std::unique_ptr` to an object with a v-table pointer header.
+template<
+    class Class, class Registry = BOOST_OPENMETHOD_DEFAULT_REGISTRY,
+    class Allocator = std::allocator<std::byte>>
+using header_vptr_unique_ptr =
+    std::unique_ptr<Class, header_vptr_deleter<Class, Registry, Allocator>>;
+
+//! Create an object with a v-table pointer header, owned by a `unique_ptr`.
+//!
+//! @tparam Class The class of the object to create.
+//! @tparam Registry A @ref registry.
+//! @tparam Allocator An allocator.
+//! @tparam T Types of the arguments to pass to the constructor of `Class`.
+//! @param alloc The allocator used to allocate the object.
+//! @param args Arguments to pass to the constructor of `Class`.
+//! @return A `header_vptr_unique_ptr<Class, Registry, Allocator>`.
+template<
+    class Class, class Registry = BOOST_OPENMETHOD_DEFAULT_REGISTRY,
+    class Allocator, typename... T>
+auto allocate_header_vptr_unique(const Allocator& alloc, T&&... args)
+    -> header_vptr_unique_ptr<Class, Registry, Allocator> {
+    header_vptr_allocator<Registry, Allocator> adapter(alloc);
+    auto obj = adapter.template new_object<Class>(std::forward<T>(args)...);
+
+    return header_vptr_unique_ptr<Class, Registry, Allocator>(
+        obj, header_vptr_deleter<Class, Registry, Allocator>(adapter));
+}
+
+//! Create an object with a v-table pointer header, owned by a `unique_ptr`.
+//!
+//! Same as @ref allocate_header_vptr_unique, using `std::allocator`.
+//!
+//! @tparam Class The class of the object to create.
+//! @tparam Registry A @ref registry.
+//! @tparam T Types of the arguments to pass to the constructor of `Class`.
+//! @param args Arguments to pass to the constructor of `Class`.
+//! @return A `header_vptr_unique_ptr<Class, Registry>`.
+template<
+    class Class, class Registry = BOOST_OPENMETHOD_DEFAULT_REGISTRY,
+    typename... T>
+auto make_header_vptr_unique(T&&... args)
+    -> header_vptr_unique_ptr<Class, Registry> {
+    return allocate_header_vptr_unique<Class, Registry>(
+        std::allocator<std::byte>(), std::forward<T>(args)...);
+}
+
+//! Create an object with a v-table pointer header, owned by a `shared_ptr`.
+//!
+//! The object is allocated separately from the control block, which is
+//! allocated with a copy of `alloc`.
+//!
+//! @tparam Class The class of the object to create.
+//! @tparam Registry A @ref registry.
+//! @tparam Allocator An allocator.
+//! @tparam T Types of the arguments to pass to the constructor of `Class`.
+//! @param alloc The allocator used to allocate the object.
+//! @param args Arguments to pass to the constructor of `Class`.
+//! @return A `std::shared_ptr<Class>`.
+template<
+    class Class, class Registry = BOOST_OPENMETHOD_DEFAULT_REGISTRY,
+    class Allocator, typename... T>
+auto allocate_header_vptr_shared(const Allocator& alloc, T&&... args)
+    -> std::shared_ptr<Class> {
+    auto obj =
+        allocate_header_vptr_unique<Class, Registry>(
+            alloc, std::forward<T>(args)...);
+    auto deleter = obj.get_deleter();
+
+    return std::shared_ptr<Class>(obj.release(), deleter, alloc);
+}
+
+//! Create an object with a v-table pointer header, owned by a `shared_ptr`.
+//!
+//! Same as @ref allocate_header_vptr_shared, using `std::allocator`.
+//!
+//! @tparam Class The class of the object to create.
+//! @tparam Registry A @ref registry.
+//! @tparam T Types of the arguments to pass to the constructor of `Class`.
+//! @param args Arguments to pass to the constructor of `Class`.
+//! @return A `std::shared_ptr<Class>`.
+template<
+    class Class, class Registry = BOOST_OPENMETHOD_DEFAULT_REGISTRY,
+    typename... T>
+auto make_header_vptr_shared(T&&... args) -> std::shared_ptr<Class> {
+    return allocate_header_vptr_shared<Class, Registry>(
+        std::allocator<std::byte>(), std::forward<T>(args)...);
+}
+
+} // namespace boost::openmethod
+
+#endif
@@ -10,8 +10,13 @@
 #include <boost/openmethod/detail/ostdstream.hpp>
 
 #include <algorithm>
+#include <charconv>
+#include <chrono>
 #include <cstdint>
+#include <cstdio>
 #include <deque>
+#include <iterator>
+#include <limits>
 #include <map>
 #include <memory>
 #include <numeric>
@@ -29,6 +34,7 @@
 #pragma warning(disable : 4456)
 #pragma warning(disable : 4458)
 #pragma warning(disable : 4702) // unreachable code
+#pragma warning(disable : 4996) // fopen
 #endif
 
 namespace boost::openmethod {
@@ -59,7 +65,91 @@ struct aggregate_reports<mp11::mp_list<Reports...>, mp11::mp_list<>, Void> {
     struct type : Reports... {};
 };
 
-inline void merge_into(boost::dynamic_bitset<>& a, boost::dynamic_bitset<>& b) {
+// Containers for the temporary data of the compiler.
+
+template<class T>
+using scratch_deque = std::deque<T, scratch_allocator<T>>;
+
+template<class Key, class T>
+using scratch_map = std::map<
+    Key, T, std::less<Key>, scratch_allocator<std::pair<const Key, T>>>;
+
+template<class Key, class T>
+using scratch_unordered_map = std::unordered_map<
+    Key, T, std::hash<Key>, std::equal_to<Key>,
+    scratch_allocator<std::pair<const Key, T>>>;
+
+template<class T>
+using scratch_unordered_set = std::unordered_set<
+    T, std::hash<T>, std::equal_to<T>, scratch_allocator<T>>;
+
+using scratch_bitset = boost::dynamic_bitset<
+    unsigned long, scratch_allocator<unsigned long>>;
+
+// Like `std::stable_sort`, but takes its buffer from the scratch allocator.
+template<class Iterator, class Compare>
+void stable_sort(Iterator first, Iterator last, Compare comp) {
+    using value_type = typename std::iterator_traits<Iterator>::value_type;
+
+    auto n = std::size_t(last - first);
+    scratch_vector<value_type> from(
+        std::make_move_iterator(first), std::make_move_iterator(last));
+    scratch_vector<value_type> to(n);
+
+    for (std::size_t width = 1; width < n; width *= 2) {
+        for (std::size_t lo = 0; lo < n; lo += 2 * width) {
+            auto mid = (std::min)(lo + width, n);
+            auto hi = (std::min)(lo + 2 * width, n);
+            std::merge(
+                std::make_move_iterator(from.begin() + lo),
+                std::make_move_iterator(from.begin() + mid),
+                std::make_move_iterator(from.begin() + mid),
+                std::make_move_iterator(from.begin() + hi), to.begin() + lo,
+                comp);
+        }
+
+        from.swap(to);
+    }
+
+    std::move(from.begin(), from.end(), first);
+}
+
+template<class Registry, typename = void>
+struct has_scratch : std::false_type {};
+
+template<class Registry>
+struct has_scratch<
+    Registry,
+    std::void_t<decltype(Registry::arena::scratch_allocate(0, 1))>>
+    : std::true_type {};
+
+// Makes the scratch allocators constructed during its lifetime allocate from
+// the registry's arena, if it provides scratch storage, or from the heap.
+template<class Registry>
+class scratch_scope {
+    const scratch_resource* previous = current_scratch;
+
+  public:
+    scratch_scope() {
+        if constexpr (has_scratch<Registry>::value) {
+            static constexpr scratch_resource resource{
+                Registry::arena::scratch_allocate,
+                Registry::arena::scratch_deallocate};
+            current_scratch = &resource;
+        } else {
+            current_scratch = nullptr;
+        }
+    }
+
+    scratch_scope(const scratch_scope&) = delete;
+    auto operator=(const scratch_scope&) -> scratch_scope& = delete;
+
+    ~scratch_scope() {
+        current_scratch = previous;
+    }
+};
+
+inline void merge_into(scratch_bitset& a, scratch_bitset& b) {
     if (b.size() < a.size()) {
         b.resize(a.size());
     }
@@ -71,7 +161,7 @@ inline void merge_into(boost::dynamic_bitset<>& a, boost::dynamic_bitset<>& b) {
     }
 }
 
-inline void set_bit(boost::dynamic_bitset<>& mask, std::size_t bit) {
+inline void set_bit(scratch_bitset& mask, std::size_t bit) {
     if (bit >= mask.size()) {
         mask.resize(bit + 1);
     }
@@ -86,6 +176,7 @@ struct generic_compiler {
     struct parameter {
         struct method* method;
         std::size_t param;
+        std::size_t heat = 0; // number of calls in profile
     };
 
     struct vtbl_entry {
@@ -94,17 +185,21 @@ struct generic_compiler {
 
     struct class_ {
         bool is_abstract = false;
-        std::vector<type_id> type_ids;
-        std::vector<class_*> transitive_bases;
-        std::vector<class_*> direct_bases;
-        std::vector<class_*> direct_derived;
-        std::unordered_set<class_*> transitive_derived;
-        std::vector<parameter> used_by_vp;
-        boost::dynamic_bitset<> used_slots;
-        boost::dynamic_bitset<> reserved_slots;
+        scratch_vector<type_id> type_ids;
+        scratch_vector<class_*> transitive_bases;
+        scratch_vector<class_*> direct_bases;
+        scratch_vector<class_*> direct_derived;
+        scratch_unordered_set<class_*> transitive_derived;
+        scratch_vector<parameter> used_by_vp;
+        scratch_bitset used_slots;
+        scratch_bitset reserved_slots;
         std::size_t first_slot = 0;
         std::size_t mark = 0; // temporary mark to detect cycles
-        std::vector<vtbl_entry> vtbl;
+        std::size_t heat = 0; // number of calls in profile
+        scratch_vector<vtbl_entry> vtbl;
+        const class_* vtbl_owner = nullptr; // if sharing its v-table
+        std::size_t number = 0, number_end = 0; // for class_intervals
+        bool contiguous = true; // subclasses are numbered number..number_end
         vptr_type* static_vptr;
 
         auto is_base_of(class_* other) const -> bool {
@@ -122,49 +217,66 @@ struct generic_compiler {
         auto type_id_end() const {
             return type_ids.end();
         }
+
+        auto slots_begin() const -> std::size_t {
+            return first_slot;
+        }
+
+        auto slots_end() const -> std::size_t {
+            return first_slot + vtbl.size();
+        }
     };
 
     struct overrider {
         detail::overrider_info* info = nullptr;
         overrider* next = nullptr;
-        std::vector<class_*> vp;
+        scratch_vector<class_*> vp;
         class_* covariant_return_type = nullptr;
         void (*pf)();
+        void (*next_pf)();
         std::size_t method_index, spec_index;
     };
 
-    using bitvec = boost::dynamic_bitset<>;
+    using bitvec = scratch_bitset;
 
     struct group {
-        std::vector<class_*> classes;
+        scratch_vector<class_*> classes;
         bool has_concrete_classes{false};
     };
 
-    using group_map = std::map<bitvec, group>;
+    using group_map = scratch_map<bitvec, group>;
 
     struct method_report {
         std::size_t cells = 0;
         std::size_t not_implemented = 0;
         std::size_t ambiguous = 0;
+        // Bytes saved by merging identical slices of the dispatch table.
+        std::size_t saved_bytes = 0;
     };
 
-    struct report : method_report {};
+    struct report : method_report {
+        // Total size of the v-tables, in words, after greedy slot allocation.
+        std::size_t greedy_vtbl_words = 0;
+        // Total size of the v-tables, in words, after slot optimization.
+        std::size_t vtbl_words = 0;
+    };
 
     static void accumulate(const method_report& partial, report& total);
 
     struct method {
         detail::method_info* info;
-        std::vector<class_*> vp;
+        scratch_vector<class_*> vp;
         class_* covariant_return_type = nullptr;
-        std::vector<overrider> overriders;
-        std::vector<std::size_t> slots;
-        std::vector<std::size_t> strides;
-        std::vector<const overrider*> dispatch_table;
+        scratch_vector<overrider> overriders;
+        scratch_vector<std::size_t> slots;
+        scratch_vector<std::size_t> strides;
+        scratch_vector<const overrider*> dispatch_table;
         // following two are dummies, when converting to a function pointer, we will
         // get the corresponding pointer from method_info
         overrider not_implemented;
         overrider ambiguous;
         vptr_type gv_dispatch_table = nullptr;
+        std::size_t heat = 0; // number of calls in profile
         auto arity() const {
             return vp.size();
         }
@@ -183,7 +295,7 @@ struct generic_compiler {
         return nullptr;
     }
 
-    std::deque<class_> classes;
+    scratch_deque<class_> classes;
 
     auto classes_begin() const {
         return classes.begin();
@@ -193,7 +305,7 @@ struct generic_compiler {
         return classes.end();
     }
 
-    std::vector<method> methods;
+    scratch_vector<method> methods;
     std::size_t class_mark = 0;
     bool compilation_done = false;
 };
@@ -353,7 +465,7 @@ auto operator<<(trace_stream<Compiler>& tr, const rflush& rf) -> auto& {
 }
 
 template<class Compiler>
-auto operator<<(trace_stream<Compiler>& tr, const boost::dynamic_bitset<>& bits)
+auto operator<<(trace_stream<Compiler>& tr, const scratch_bitset& bits)
     -> auto& {
     if constexpr (Compiler::has_trace) {
         if (tr.on) {
@@ -395,10 +507,12 @@ template<class... Options>
 struct registry<Policies...>::compiler : detail::generic_compiler {
     using type_index_type = decltype(rtti::type_index(0));
 
-    typename detail::aggregate_reports<mp11::mp_list<report>, policy_list>::type
-        report;
+    using report_type = typename detail::aggregate_reports<
+        mp11::mp_list<report>, policy_list>::type;
 
-    std::unordered_map<type_index_type, class_*> class_map;
+    report_type report;
+
+    detail::scratch_unordered_map<type_index_type, class_*> class_map;
 
     using Registry = registry;
 
@@ -412,18 +526,23 @@ struct registry<Policies...>::compiler : detail::generic_compiler {
     void collect_transitive_bases(class_* cls, class_* base);
     void calculate_transitive_derived(class_& cls);
     void augment_methods();
+    void load_profile();
     void assign_slots();
     void assign_tree_slots(class_& cls, std::size_t base_slot);
     void assign_lattice_slots(class_& cls);
+    void optimize_lattice_slots();
     void build_dispatch_tables();
     void build_dispatch_table(
         method& m, std::size_t dim,
-        std::vector<group_map>::const_iterator group, const bitvec& candidates,
-        bool concrete);
+        detail::scratch_vector<group_map>::const_iterator group,
+        const bitvec& candidates, bool concrete);
+    void compress_dispatch_table(
+        method& m, const detail::scratch_vector<group_map>& groups);
+    void number_classes();
     void write_global_data();
     void print(const method_report& report) const;
     static void select_dominant_overriders(
-        std::vector<overrider*>& dominants, std::size_t& pick,
+        detail::scratch_vector<overrider*>& dominants, std::size_t& pick,
         std::size_t& remaining);
     static auto
     is_more_specific(const overrider* a, const overrider* b) -> bool;
@@ -438,6 +557,8 @@ struct registry<Policies...>::compiler : detail::generic_compiler {
     static constexpr bool has_trace = has_option<trace>;
     static constexpr bool has_n2216 = has_option<n2216>;
 
+    std::chrono::microseconds slot_optimizer_budget = slot_budget().duration;
+
     mutable detail::trace_stream<compiler> tr;
     using indent = typename detail::trace_stream<compiler>::indent;
 };
@@ -460,6 +581,11 @@ template<class... Options>
 auto registry<Policies...>::compiler<Options...>::compile() {
     augment_classes();
     augment_methods();
+
+    if constexpr (has_option<profile>) {
+        load_profile();
+    }
+
     assign_slots();
     build_dispatch_tables();
 
@@ -510,6 +636,17 @@ registry<Policies...>::compiler<Options...>::compiler(Options... opts)
 #else
         // Even with the constexpr has_trace guard, msvc errors on this.
         tr.on = std::get<trace>(options).on;
+#endif
+    }
+
+    if constexpr (has_option<slot_budget>) {
+#ifdef _MSC_VER
+        slot_optimizer_budget =
+            detail::msvc_tuple_get<has_option<slot_budget>, slot_budget>::fn(
+                options)
+                .duration;
+#else
+        slot_optimizer_budget = std::get<slot_budget>(options).duration;
 #endif
     }
 }
@@ -760,9 +897,12 @@ void registry<Policies...>::compiler<Options...>::augment_methods() {
         const auto method_index = meth_iter - methods.begin();
         auto spec_size = meth_info.overriders.size();
         meth_iter->not_implemented.pf = meth_iter->info->not_implemented;
+        meth_iter->not_implemented.next_pf =
+            meth_iter->info->next_not_implemented;
         meth_iter->not_implemented.method_index = method_index;
         meth_iter->not_implemented.spec_index = spec_size;
         meth_iter->ambiguous.pf = meth_iter->info->ambiguous;
+        meth_iter->ambiguous.next_pf = meth_iter->info->next_ambiguous;
         meth_iter->ambiguous.method_index = method_index;
         meth_iter->ambiguous.spec_index = spec_size + 1;
 
@@ -803,6 +943,7 @@ void registry<Policies...>::compiler<Options...>::augment_methods() {
                 }
 
                 spec_iter->pf = spec_iter->info->pf;
+                spec_iter->next_pf = spec_iter->info->next_pf;
                 spec_iter->vp.push_back(class_);
             }
 
@@ -858,11 +999,118 @@ void registry<Policies...>::compiler<Options...>::augment_methods() {
     }
 }
 
+template<class... Policies>
+template<class... Options>
+void registry<Policies...>::compiler<Options...>::load_profile() {
+    using namespace detail;
+
+    auto& path = std::get<profile>(options).path;
+    ++tr << "Reading profile " << path << "\n";
+    indent _(tr);
+
+    auto file = std::fopen(path.c_str(), "r");
+
+    if (!file) {
+        ++tr << "cannot open, using default layout\n";
+        return;
+    }
+
+    std::unordered_map<std::string, class_*> class_by_name;
+    std::unordered_map<std::string, method*> method_by_name;
+
+    for (auto& cls : classes) {
+        ostrstream name;
+        rtti::type_name(cls.type_ids[0], name);
+        class_by_name[name.str] = &cls;
+    }
+
+    for (auto& m : methods) {
+        ostrstream name;
+        rtti::type_name(m.info->method_type_id, name);
+        method_by_name[name.str] = &m;
+    }
+
+    std::string line;
+
+    // Each line contains: count, param, method name, class name, separated
+    // by tabs.
+    while (read_line(file, line)) {
+        auto count_end = line.find('\t');
+
+        if (count_end == std::string::npos) {
+            continue;
+        }
+
+        auto param_end = line.find('\t', count_end + 1);
+
+        if (param_end == std::string::npos) {
+            continue;
+        }
+
+        auto method_end = line.find('\t', param_end + 1);
+
+        if (method_end == std::string::npos) {
+            continue;
+        }
+
+        std::size_t count, param;
+        auto first = line.data();
+
+        if (std::from_chars(first, first + count_end, count).ptr !=
+                first + count_end ||
+            std::from_chars(first + count_end + 1, first + param_end, param)
+                    .ptr != first + param_end) {
+            continue;
+        }
+
+        auto method_name =
+            line.substr(param_end + 1, method_end - param_end - 1);
+        auto class_name = line.substr(method_end + 1);
+
+        auto method_iter = method_by_name.find(method_name);
+        auto class_iter = class_by_name.find(class_name);
+
+        if (method_iter == method_by_name.end() ||
+            class_iter == class_by_name.end()) {
+            continue;
+        }
+
+        auto& m = *method_iter->second;
+        auto cls = class_iter->second;
+
+        // Discard counts that don't match the hierarchy, e.g. from a profile of
+        // a different version of the program.
+        if (param >= m.arity() || !m.vp[param]->is_base_of(cls)) {
+            continue;
+        }
+
+        m.heat += count;
+        cls->heat += count;
+
+        for (auto& mp : m.vp[param]->used_by_vp) {
+            if (mp.method == &m && mp.param == param) {
+                mp.heat += count;
+            }
+        }
+    }
+
+    std::fclose(file);
+
+    // Hot parameters get the lowest slots.
+    for (auto& cls : classes) {
+        detail::stable_sort(
+            cls.used_by_vp.begin(), cls.used_by_vp.end(),
+            [](const auto& a, const auto& b) { return a.heat > b.heat; });
+    }
+}
+
 template<class... Policies>
 template<class... Options>
 void registry<Policies...>::compiler<Options...>::assign_slots() {
     ++tr << "Allocating slots...\n";
 
+    auto has_lattices = false;
+
     {
         indent _(tr);
 
@@ -879,6 +1127,7 @@ void registry<Policies...>::compiler<Options...>::assign_slots() {
                     assign_tree_slots(cls, 0);
                 } else {
                     assign_lattice_slots(cls);
+                    has_lattices = true;
                 }
             }
         }
@@ -897,13 +1146,27 @@ void registry<Policies...>::compiler<Options...>::assign_slots() {
 
             auto first_slot = cls.used_slots.find_first();
             cls.first_slot =
-                first_slot == boost::dynamic_bitset<>::npos ? 0u : first_slot;
+                first_slot == detail::scratch_bitset::npos ? 0u : first_slot;
             cls.vtbl.resize(cls.used_slots.size() - cls.first_slot);
             ++tr << cls << " vtbl: " << cls.first_slot << "-"
                  << cls.used_slots.size() << " slots " << cls.used_slots
                  << "\n";
         }
     }
+
+    auto vtbl_words = [this]() {
+        return std::accumulate(
+            classes.begin(), classes.end(), std::size_t(0),
+            [](auto sum, const auto& cls) { return sum + cls.vtbl.size(); });
+    };
+
+    report.greedy_vtbl_words = vtbl_words();
+
+    if (has_lattices && slot_optimizer_budget.count() > 0) {
+        optimize_lattice_slots();
+    }
+
+    report.vtbl_words = vtbl_words();
 }
 
 template<class... Policies>
@@ -1006,6 +1269,165 @@ void registry<Policies...>::compiler<Options...>::assign_lattice_slots(
     }
 }
 
+// Re-assigns the slots used in multiple inheritance lattices, trying to
+// minimize the total size of the v-tables.
+//
+// Two slots conflict if they are used by the same class, i.e. if the classes of
+// the virtual parameters that they stand for have a common derived class. The
+// conflicts form an interference graph, which is colored with slot numbers.
+// The parameters are colored in order of decreasing number of classes using
+// them, each time picking the slot - possibly to the left of the slots already
+// assigned - that extends the v-tables the least. The greedy assignment is kept
+// if it is better, or if the optimizer runs out of time.
+template<class... Policies>
+template<class... Options>
+void registry<Policies...>::compiler<Options...>::optimize_lattice_slots() {
+    using namespace detail;
+    using clock = std::chrono::steady_clock;
+
+    auto deadline = clock::now() + slot_optimizer_budget;
+
+    ++tr << "Optimizing MI v-tables...\n";
+    indent _(tr);
+
+    detail::scratch_vector<class_*> lattice;
+    detail::scratch_unordered_map<const class_*, std::size_t> lattice_index;
+    std::size_t greedy_words = 0;
+
+    for (auto& cls : classes) {
+        if (cls.mark == class_mark) {
+            lattice_index[&cls] = lattice.size();
+            lattice.push_back(&cls);
+            greedy_words += cls.vtbl.size();
+        }
+    }
+
+    struct variable {
+        const parameter* param;
+        detail::scratch_vector<std::size_t> users;
+        std::ptrdiff_t slot;
+    };
+
+    detail::scratch_vector<variable> variables;
+
+    for (auto cls : lattice) {
+        for (const auto& mp : cls->used_by_vp) {
+            auto& var = variables.emplace_back();
+            var.param = &mp;
+
+            for (auto derived : cls->transitive_derived) {
+                var.users.push_back(lattice_index[derived]);
+            }
+        }
+    }
+
+    // All the slots lie in [-n, n], where n is the number of variables.
+    auto n = std::ptrdiff_t(variables.size());
+    auto width = std::size_t(2 * n + 1);
+
+    if (lattice.size() * width > (std::size_t(1) << 24)) {
+        ++tr << "too many classes and slots, keeping greedy allocation\n";
+        return;
+    }
+
+    detail::stable_sort(
+        variables.begin(), variables.end(), [](const auto& a, const auto& b) {
+            return a.users.size() > b.users.size();
+        });
+
+    detail::scratch_vector<detail::scratch_bitset> occupied(
+        lattice.size(), detail::scratch_bitset(width));
+    // Range of slots used by each class; empty if first > last.
+    detail::scratch_vector<std::ptrdiff_t> first(lattice.size(), 0);
+    detail::scratch_vector<std::ptrdiff_t> last(lattice.size(), -1);
+    std::ptrdiff_t lo = 0, hi = 0;
+
+    for (auto& var : variables) {
+        if (clock::now() > deadline) {
+            ++tr << "out of time, keeping greedy allocation\n";
+            return;
+        }
+
+        auto best_cost = (std::numeric_limits<std::size_t>::max)();
+        std::ptrdiff_t best_slot = 0;
+
+        for (auto slot = lo - 1; slot <= hi + 1; ++slot) {
+            std::size_t cost = 0;
+            auto free = true;
+
+            for (auto user : var.users) {
+                if (occupied[user][std::size_t(slot + n)]) {
+                    free = false;
+                    break;
+                }
+
+                if (first[user] > last[user]) {
+                    cost += 1;
+                } else if (slot < first[user]) {
+                    cost += std::size_t(first[user] - slot);
+                } else if (slot > last[user]) {
+                    cost += std::size_t(slot - last[user]);
+                }
+            }
+
+            if (free &&
+                (cost < best_cost ||
+                 (cost == best_cost && std::abs(slot) < std::abs(best_slot)))) {
+                best_cost = cost;
+                best_slot = slot;
+            }
+        }
+
+        var.slot = best_slot;
+        lo = (std::min)(lo, best_slot);
+        hi = (std::max)(hi, best_slot);
+
+        for (auto user : var.users) {
+            occupied[user][std::size_t(best_slot + n)] = true;
+
+            if (first[user] > last[user]) {
+                first[user] = last[user] = best_slot;
+            } else {
+                first[user] = (std::min)(first[user], best_slot);
+                last[user] = (std::max)(last[user], best_slot);
+            }
+        }
+    }
+
+    std::size_t words = 0;
+
+    for (std::size_t i = 0; i < lattice.size(); ++i) {
+        words += std::size_t(last[i] - first[i] + 1);
+    }
+
+    ++tr << "v-table words: greedy " << greedy_words << ", optimized " << words
+         << "\n";
+
+    if (words >= greedy_words) {
+        return;
+    }
+
+    for (auto& var : variables) {
+        var.param->method->slots[var.param->param] =
+            std::size_t(var.slot - lo);
+    }
+
+    for (std::size_t i = 0; i < lattice.size(); ++i) {
+        auto& cls = *lattice[i];
+        cls.vtbl.clear();
+
+        if (first[i] > last[i]) {
+            cls.first_slot = 0;
+        } else {
+            cls.first_slot = std::size_t(first[i] - lo);
+            cls.vtbl.resize(std::size_t(last[i] - first[i] + 1));
+        }
+
+        ++tr << cls << " vtbl: " << cls.first_slot << "-"
+             << cls.first_slot + cls.vtbl.size() << "\n";
+    }
+}
+
 template<class... Policies>
 template<class... Options>
 void registry<Policies...>::compiler<Options...>::build_dispatch_tables() {
@@ -1018,7 +1440,7 @@ void registry<Policies...>::compiler<Options...>::build_dispatch_tables() {
 
         auto dims = m.arity();
 
-        std::vector<group_map> groups;
+        detail::scratch_vector<group_map> groups;
         groups.resize(dims);
 
         {
@@ -1125,6 +1547,8 @@ void registry<Policies...>::compiler<Options...>::build_dispatch_tables() {
                 }
 
                 tr << "\n";
+
+                compress_dispatch_table(m, groups);
             }
 
             print(m.report);
@@ -1133,12 +1557,102 @@ void registry<Policies...>::compiler<Options...>::build_dispatch_tables() {
     }
 }
 
+template<class... Policies>
+template<class... Options>
+void registry<Policies...>::compiler<Options...>::compress_dispatch_table(
+    method& m, const detail::scratch_vector<group_map>& groups) {
+    // Two groups in the same dimension can select identical slices of the
+    // dispatch table, when the overriders that tell them apart never win, e.g.
+    // because the cells are ambiguous either way. Merge them, renumber the
+    // groups in the v-tables, and recompute the strides. This is free at
+    // dispatch time.
+    using namespace detail;
+
+    detail::scratch_vector<std::size_t> sizes;
+
+    for (const auto& dim_groups : groups) {
+        sizes.push_back(dim_groups.size());
+    }
+
+    auto cells = m.dispatch_table.size();
+
+    for (std::size_t dim = 0; dim < m.arity(); ++dim) {
+        std::size_t stride = 1;
+
+        for (std::size_t d = 0; d < dim; ++d) {
+            stride *= sizes[d];
+        }
+
+        auto size = sizes[dim];
+        scratch_vector<scratch_vector<const overrider*>> slices(size);
+
+        for (std::size_t i = 0; i < m.dispatch_table.size(); ++i) {
+            slices[i / stride % size].push_back(m.dispatch_table[i]);
+        }
+
+        // Map each group to the first group with the same slice.
+        scratch_map<scratch_vector<const overrider*>, std::size_t> distinct;
+        detail::scratch_vector<std::size_t> remap(size), kept;
+
+        for (std::size_t g = 0; g < size; ++g) {
+            auto [iter, inserted] = distinct.emplace(slices[g], kept.size());
+            remap[g] = iter->second;
+
+            if (inserted) {
+                kept.push_back(g);
+            }
+        }
+
+        if (kept.size() == size) {
+            continue;
+        }
+
+        ++tr << "merged " << size - kept.size() << " group(s) in dim " << dim
+             << "\n";
+
+        // Keeping the cells of the first group of each kind, in order, yields
+        // the table for the merged groups.
+        detail::scratch_vector<const overrider*> table;
+        table.reserve(m.dispatch_table.size() / size * kept.size());
+
+        for (std::size_t i = 0; i < m.dispatch_table.size(); ++i) {
+            auto g = i / stride % size;
+
+            if (kept[remap[g]] == g) {
+                table.push_back(m.dispatch_table[i]);
+            }
+        }
+
+        m.dispatch_table.swap(table);
+        sizes[dim] = kept.size();
+
+        std::size_t g = 0;
+
+        for (const auto& [mask, group] : groups[dim]) {
+            for (auto cls : group.classes) {
+                cls->vtbl[m.slots[dim] - cls->first_slot].group_index =
+                    remap[g];
+            }
+
+            ++g;
+        }
+    }
+
+    for (std::size_t dim = 1, stride = 1; dim < m.arity(); ++dim) {
+        stride *= sizes[dim - 1];
+        m.strides[dim - 1] = stride;
+    }
+
+    m.report.cells = m.dispatch_table.size();
+    m.report.saved_bytes = (cells - m.report.cells) * sizeof(word);
+}
+
 template<class... Policies>
 template<class... Options>
 void registry<Policies...>::compiler<Options...>::build_dispatch_table(
     method& m, std::size_t dim,
-    std::vector<group_map>::const_iterator group_iter, const bitvec& candidates,
-    bool concrete) {
+    detail::scratch_vector<group_map>::const_iterator group_iter,
+    const bitvec& candidates, bool concrete) {
     using namespace detail;
 
     indent _(tr);
@@ -1157,7 +1671,7 @@ void registry<Policies...>::compiler<Options...>::build_dispatch_table(
         }
 
         if (dim == 0) {
-            std::vector<overrider*> overriders;
+            detail::scratch_vector<overrider*> overriders;
             std::size_t i = 0;
 
             for (auto& spec : m.overriders) {
@@ -1177,7 +1691,7 @@ void registry<Policies...>::compiler<Options...>::build_dispatch_table(
                 }
             }
 
-            std::vector<overrider*> dominants = overriders;
+            detail::scratch_vector<overrider*> dominants = overriders;
             std::size_t pick, remaining;
 
             select_dominant_overriders(dominants, pick, remaining);
@@ -1285,34 +1799,193 @@ void registry<Policies...>::compiler<Options...>::build_dispatch_table(
 inline void detail::generic_compiler::accumulate(
     const method_report& partial, report& total) {
     total.cells += partial.cells;
+    total.saved_bytes += partial.saved_bytes;
     total.not_implemented += partial.not_implemented != 0;
     total.ambiguous += partial.ambiguous != 0;
 }
 
+template<class... Policies>
+template<class... Options>
+void registry<Policies...>::compiler<Options...>::number_classes() {
+    // Number the classes in depth-first preorder, starting from the roots.
+    // With single inheritance, the subclasses of a class are numbered
+    // contiguously, right after it. With multiple inheritance, a class reached
+    // from several bases is numbered under the first one only, and its other
+    // bases need a bitmap.
+    constexpr auto unnumbered = (std::numeric_limits<std::size_t>::max)();
+
+    for (auto& cls : classes) {
+        cls.number = unnumbered;
+    }
+
+    std::size_t next = 0;
+    detail::scratch_vector<class_*> stack;
+
+    for (auto& root : classes) {
+        if (!root.direct_bases.empty()) {
+            continue;
+        }
+
+        stack.push_back(&root);
+
+        while (!stack.empty()) {
+            auto cls = stack.back();
+            stack.pop_back();
+
+            if (cls->number != unnumbered) {
+                continue;
+            }
+
+            cls->number = next++;
+            stack.insert(
+                stack.end(), cls->direct_derived.rbegin(),
+                cls->direct_derived.rend());
+        }
+    }
+
+    for (auto& cls : classes) {
+        auto lo = cls.number, hi = cls.number;
+
+        for (auto derived : cls.transitive_derived) {
+            lo = (std::min)(lo, derived->number);
+            hi = (std::max)(hi, derived->number);
+        }
+
+        cls.number_end = hi + 1;
+        cls.contiguous =
+            lo == cls.number && cls.transitive_derived.size() == hi + 1 - lo;
+    }
+}
+
 template<class... Policies>
 template<class... Options>
 void registry<Policies...>::compiler<Options...>::write_global_data() {
     using namespace policies;
     using namespace detail;
 
+    // Lay out the dispatch tables and v-tables in decreasing order of calls, if
+    // a profile was loaded; otherwise, in the order of `methods` and `classes`.
+    auto by_heat = [](auto& container) {
+        scratch_vector<std::remove_reference_t<decltype(*container.begin())>*>
+            result;
+
+        for (auto& item : container) {
+            result.push_back(&item);
+        }
+
+        detail::stable_sort(
+            result.begin(), result.end(),
+            [](auto a, auto b) { return a->heat > b->heat; });
+
+        return result;
+    };
+
+    auto method_order = by_heat(methods);
+    auto class_order = by_heat(classes);
+
     auto dispatch_data_size = std::accumulate(
         methods.begin(), methods.end(), std::size_t(0),
         [](std::size_t sum, const method& m) {
             // msvc doesn't like (auto sum, auto& m) (C2187), go figure...
             return sum + m.dispatch_table.size();
         });
-    dispatch_data_size = std::accumulate(
-        classes.begin(), classes.end(), dispatch_data_size,
-        [](auto sum, const auto& cls) { return sum + cls.vtbl.size(); });
 
-    std::vector<detail::word> new_dispatch_data(dispatch_data_size);
+    // Words per subclass bitmap, for class_intervals.
+    [[maybe_unused]] std::size_t bitmap_size = 0;
+
+    if constexpr (has_class_intervals) {
+        number_classes();
+        bitmap_size = (classes.size() + bits_per_word - 1) / bits_per_word;
+
+        for (auto& cls : classes) {
+            dispatch_data_size += class_header_size + cls.first_slot;
+
+            if (!cls.contiguous) {
+                dispatch_data_size += bitmap_size;
+            }
+        }
+    }
+
+    {
+        // Classes with identical v-tables - typically, classes that do not
+        // override anything - share a single copy. Compare what would be
+        // written, before the dispatch tables are allocated: function
+        // pointers for uni-methods; method and group indexes for
+        // multi-methods.
+        scratch_map<scratch_vector<std::uintptr_t>, const class_*> vtbls;
+
+        for (auto cls : class_order) {
+            scratch_vector<std::uintptr_t> key{cls->first_slot};
+
+            if constexpr (has_class_intervals) {
+                // The header makes each v-table unique.
+                key.push_back(reinterpret_cast<std::uintptr_t>(cls));
+            }
+
+            for (auto& entry : cls->vtbl) {
+                auto& method = methods[entry.method_index];
+
+                if (method.arity() == 1) {
+                    key.push_back(0);
+                    key.push_back(reinterpret_cast<std::uintptr_t>(
+                        method.dispatch_table[entry.group_index]->pf));
+                } else if (entry.vp_index == 0) {
+                    key.push_back(entry.method_index + 1);
+                    key.push_back(entry.group_index);
+                } else {
+                    key.push_back((std::numeric_limits<std::uintptr_t>::max)());
+                    key.push_back(entry.group_index);
+                }
+            }
+
+            auto [iter, inserted] = vtbls.emplace(std::move(key), cls);
+
+            if (inserted) {
+                cls->vtbl_owner = nullptr;
+                dispatch_data_size += cls->vtbl.size();
+            } else {
+                cls->vtbl_owner = iter->second;
+            }
+        }
+    }
+
+    if constexpr (has_arena) {
+        arena::begin_update();
+    }
+
+    runtime_vector<detail::word, registry> new_dispatch_data(
+        dispatch_data_size);
     auto gv_first = new_dispatch_data.data();
     [[maybe_unused]] auto gv_last = gv_first + dispatch_data_size;
     auto gv_iter = gv_first;
 
     ++tr << "Initializing multi-method dispatch tables at " << gv_iter << "\n";
 
-    for (auto& m : methods) {
+    for (auto mp : method_order) {
+        auto& m = *mp;
+
+        // A method that resolves to the same overrider for all the
+        // combinations of virtual arguments can bypass dispatch.
+        const overrider* single =
+            m.dispatch_table.empty() ? nullptr : m.dispatch_table[0];
+
+        if (single == &m.not_implemented || single == &m.ambiguous) {
+            single = nullptr;
+        }
+
+        for (auto spec : m.dispatch_table) {
+            if (spec != single) {
+                single = nullptr;
+                break;
+            }
+        }
+
+        m.info->monomorphic = single ? single->pf : nullptr;
+
+        if (single) {
+            ++tr << type_name(m.info->method_type_id) << " is monomorphic\n";
+        }
+
         if (m.info->arity() == 1) {
             // Uni-methods just need an index in the method table.
             m.info->slots_strides_ptr[0] = m.slots[0];
@@ -1354,8 +2027,7 @@ void registry<Policies...>::compiler<Options...>::write_global_data() {
 
                 tr << "#" << overrider.next->spec_index << " "
                    << spec_name(m, overrider.next);
-                *overrider.info->next =
-                    reinterpret_cast<void (*)()>(overrider.next->pf);
+                *overrider.info->next = overrider.next->next_pf;
             } else {
                 tr << "none";
             }
@@ -1366,7 +2038,39 @@ void registry<Policies...>::compiler<Options...>::write_global_data() {
 
     ++tr << "Initializing v-tables at " << gv_iter << "\n";
 
-    for (auto& cls : classes) {
+    for (auto cls_ptr : class_order) {
+        auto& cls = *cls_ptr;
+
+        if (cls.vtbl_owner) {
+            continue;
+        }
+
+        if constexpr (has_class_intervals) {
+            word* bitmap = nullptr;
+
+            if (!cls.contiguous) {
+                bitmap = gv_iter;
+                gv_iter = std::fill_n(gv_iter, bitmap_size, std::size_t(0));
+
+                for (auto derived : cls.transitive_derived) {
+                    bitmap[derived->number / bits_per_word].i |=
+                        std::size_t(1) << derived->number % bits_per_word;
+                }
+            }
+
+            ++tr << cls << " is #" << cls.number << ", subclasses "
+                 << cls.number << "-" << cls.number_end
+                 << (bitmap ? " (bitmap)" : "") << "\n";
+
+            BOOST_ASSERT(
+                gv_iter + class_header_size + cls.first_slot <= gv_last);
+            *gv_iter++ = bitmap;
+            *gv_iter++ = cls.number_end;
+            *gv_iter++ = cls.number;
+            // Leave room for the slots before the first one used by the class.
+            gv_iter = std::fill_n(gv_iter, cls.first_slot, std::size_t(0));
+        }
+
         *cls.static_vptr = gv_iter - cls.first_slot;
 
         ++tr << rflush(4, gv_iter - gv_first) << " " << gv_iter << " vtbl for "
@@ -1407,17 +2111,42 @@ void registry<Policies...>::compiler<Options...>::write_global_data() {
 
     ++tr << rflush(4, dispatch_data_size) << " " << gv_iter << " end\n";
 
+    for (auto& cls : classes) {
+        if (cls.vtbl_owner) {
+            ++tr << cls << " shares v-table of " << *cls.vtbl_owner << "\n";
+            *cls.static_vptr = *cls.vtbl_owner->static_vptr;
+        }
+    }
+
     if constexpr (has_vptr) {
         vptr::initialize(*this, options);
     }
 
+    if constexpr (has_profiler) {
+        profiler::initialize(*this, options);
+    }
+
+    if constexpr (has_class_intervals) {
+        runtime_vector<vptr_type, registry> new_class_vptrs(classes.size());
+
+        for (auto& cls : classes) {
+            new_class_vptrs[cls.number] = *cls.static_vptr;
+        }
+
+        new_class_vptrs.swap(class_vptrs);
+    }
+
     new_dispatch_data.swap(dispatch_data);
+
+    if constexpr (has_arena) {
+        arena::end_update();
+    }
 }
 
 template<class... Policies>
 template<class... Options>
 void registry<Policies...>::compiler<Options...>::select_dominant_overriders(
-    std::vector<overrider*>& candidates, std::size_t& pick,
+    detail::scratch_vector<overrider*>& candidates, std::size_t& pick,
     std::size_t& remaining) {
 
     pick = 0;
@@ -1536,29 +2265,48 @@ void registry<Policies...>::compiler<Options...>::print(
     if (r.cells) {
         // only for multi-methods, uni-methods don't have dispatch tables
         ++tr << r.cells << " dispatch table cells, ";
+
+        if (r.saved_bytes) {
+            tr << r.saved_bytes << " bytes saved by merging, ";
+        }
     }
 
     tr << r.not_implemented << " not implemented, " << r.ambiguous
        << " ambiguous\n";
 }
 
+//! The result of @ref initialize.
+//!
+//! @tparam Report The type of the report.
+template<class Report>
+struct initialize_result {
+    //! Statistics about the dispatch tables.
+    Report report;
+};
+
 //! Initialize a registry.
 //!
 //! Initialize the @ref registry passed as an explicit function template
 //! argument, or @ref default_registry if the registry is not specified. The
 //! default can be changed by defining {{BOOST_OPENMETHOD_DEFAULT_REGISTRY}}.
 //! Option objects can be passed to change the behavior of the function.
-//! Currently two options exist:
+//! Currently three options exist:
 //! @li @ref trace Enable tracing of the initialization process.
 //! @li @ref n2216 Enable resolution of ambiguities according to the N2216
 //! paper.
+//! @li @ref retain_compiler Return the compiler object instead of just a
+//! report.
 //!
 //! `initialize` must be called, typically at the beginning of `main`, before
 //! using any of the methods in a registry. It sets up the v-tables,
 //! multi-method dispatch tables, and any other data required by the policies.
 //!
-//! The function returns an object of an unspecified type that contains a
-//! `report` member, itself an object of an unspecified type, thatcontains the
+//! The data structures used to build the dispatch tables are allocated from
+//! the registry's scratch storage - see @ref policies::static_arena - or from
+//! the heap, and released before the function returns, unless the @ref
+//! retain_compiler option is passed. It returns an @ref initialize_result -
+//! or, if `retain_compiler` is passed, the compiler object - that contains a
+//! `report` member, itself an object of an unspecified type, that contains the
 //! following members:
 //! @li `std::size_t cells`: The number of cells in all multi-method dispatch
 //! tables.
@@ -1575,7 +2323,8 @@ void registry<Policies...>::compiler<Options...>::print(
 //! @tparam Options... Zero or more option types, deduced from the function
 //! arguments.
 //! @param options Zero or more option objects.
-//! @return An object of an unspecified type.
+//! @return An @ref initialize_result, or an object of an unspecified type if
+//! `retain_compiler` is passed.
 //!
 //! @par Errors
 //!
@@ -1621,11 +2370,29 @@ inline auto initialize(Options&&... options) {
         std::abort();
     }
 
-    typename Registry::template compiler<Options...> comp(
-        std::forward<Options>(options)...);
-    comp.initialize();
+    using compiler = typename Registry::template compiler<Options...>;
+    detail::scratch_scope<Registry> scratch;
+
+    if constexpr (mp11::mp_contains<
+                      mp11::mp_list<std::decay_t<Options>...>,
+                      retain_compiler>::value) {
+        compiler comp(std::forward<Options>(options)...);
+        comp.initialize();
 
-    return comp;
+        return comp;
+    } else {
+        // The compiler's classes, methods, class_map, etc, are destroyed
+        // before returning.
+        initialize_result<typename compiler::report_type> result;
+
+        {
+            compiler comp(std::forward<Options>(options)...);
+            comp.initialize();
+            result.report = comp.report;
+        }
+
+        return result;
+    }
 }
 
 namespace detail {
@@ -1652,7 +2419,12 @@ auto registry<Policies...>::finalize(Options... opts) -> void {
         }
     });
 
+    for (auto& m : methods) {
+        m.monomorphic = nullptr;
+    }
+
     dispatch_data.clear();
+    class_vptrs.clear();
     initialized = false;
 }
 
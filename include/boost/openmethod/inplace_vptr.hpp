@@ -3,6 +3,8 @@
 
 #include <boost/openmethod/core.hpp>
 
+#include <cstdint>
+
 // =============================================================================
 // inplace_vptr
 
@@ -31,13 +33,26 @@ struct update_vptr_bases<mp11::mp_list<Bases...>> {
     }
 };
 
+// The type of the v-table pointer embedded in objects: a class number, plus
+// one, so that zero means none; a pointer to the v-table pointer; or the
+// v-table pointer itself.
+template<class Registry>
+using inplace_vptr_type = std::conditional_t<
+    Registry::has_compact_inplace_vptr, std::uint32_t,
+    std::conditional_t<
+        Registry::has_indirect_vptr, const vptr_type*, vptr_type>>;
+
 template<class To, class Class>
 void boost_openmethod_update_vptr(Class* obj) {
     using registry = inplace_vptr_registry<Class>;
     using bases = decltype(boost_openmethod_bases(obj));
 
     if constexpr (mp11::mp_size<bases>::value == 0) {
-        if constexpr (registry::has_indirect_vptr) {
+        if constexpr (registry::has_compact_inplace_vptr) {
+            auto vptr = registry::template static_vptr<To>;
+            obj->boost_openmethod_vptr =
+                vptr ? std::uint32_t(vptr[class_number].i + 1) : 0;
+        } else if constexpr (registry::has_indirect_vptr) {
             obj->boost_openmethod_vptr = &registry::template static_vptr<To>;
         } else {
             obj->boost_openmethod_vptr = registry::template static_vptr<To>;
@@ -47,6 +62,30 @@ void boost_openmethod_update_vptr(Class* obj) {
     }
 }
 
+// Whether the constructor of `Class` sets the v-table pointer. Under
+// final_inplace_vptr, only the most derived class does, once.
+template<class Class, class Registry>
+constexpr bool stamps_inplace_vptr =
+    !Registry::has_final_inplace_vptr || std::is_final_v<Class>;
+
+// Report an object whose embedded v-table pointer was not set, then abort.
+template<class Registry, class Class>
+[[noreturn]] void missing_inplace_vptr(const Class& obj) {
+    if constexpr (Registry::has_error_handler) {
+        missing_class error;
+
+        if constexpr (Registry::rtti::template is_polymorphic<Class>) {
+            error.type = Registry::rtti::dynamic_type(obj);
+        } else {
+            error.type = Registry::rtti::template static_type<Class>();
+        }
+
+        Registry::error_handler::error(error);
+    }
+
+    abort();
+}
+
 #if defined(__GNUC__) && !defined(__clang__)
 #pragma GCC diagnostic ignored "-Wnon-template-friend"
 #endif
@@ -80,6 +119,22 @@ class inplace_vptr_base_tag {};
 //! pointer is stored as a pointer to a pointer, and remains valid after a call
 //! to @ref initialize.
 //!
+//! If `Registry` contains the @ref compact_inplace_vptr policy, a 32-bit class
+//! number is stored instead, and the v-table pointer is looked up in @ref
+//! registry::class_vptrs. The number also remains valid after a new call to
+//! @ref initialize, provided that the same classes are registered. Objects
+//! must be constructed after `initialize`. If `Registry` contains the @ref
+//! runtime_checks policy, using an object constructed before `initialize`
+//! calls the @ref error_handler with a @ref missing_class value, then
+//! terminates the program with @ref abort.
+//!
+//! If `Registry` contains the @ref final_inplace_vptr policy, the v-table
+//! pointer is set once, by the constructor of the most derived class, which
+//! must be `final`. If `Registry` also contains the @ref runtime_checks
+//! policy, using an object of a class that is not `final` calls the @ref
+//! error_handler with a @ref missing_class value, then terminates the program
+//! with @ref abort.
+//!
 //! The default value of `Registry` can be changed by defining
 //! {{BOOST_OPENMETHOD_DEFAULT_REGISTRY}}
 //!
@@ -131,12 +186,29 @@ class inplace_vptr_base : protected detail::inplace_vptr_base_tag {
     friend auto boost_openmethod_registry(Class*) -> Registry;
     friend auto boost_openmethod_bases(Class*) -> mp11::mp_list<>;
 
-    std::conditional_t<Registry::has_indirect_vptr, const vptr_type*, vptr_type>
-        boost_openmethod_vptr = nullptr;
+    static_assert(
+        !Registry::has_compact_inplace_vptr || Registry::has_class_intervals,
+        "compact_inplace_vptr requires the class_intervals policy");
+
+    detail::inplace_vptr_type<Registry> boost_openmethod_vptr{};
+
+    friend auto boost_openmethod_vptr(const Class& obj, Registry*) noexcept(
+        !Registry::has_runtime_checks) -> vptr_type {
+        if constexpr (
+            Registry::has_runtime_checks &&
+            (Registry::has_compact_inplace_vptr ||
+             Registry::has_final_inplace_vptr)) {
+            // Zero or null: the object was constructed before `initialize`,
+            // under compact_inplace_vptr; or its class is not `final`, under
+            // final_inplace_vptr.
+            if (!obj.boost_openmethod_vptr) {
+                detail::missing_inplace_vptr<Registry>(obj);
+            }
+        }
 
-    friend auto
-    boost_openmethod_vptr(const Class& obj, Registry*) noexcept -> vptr_type {
-        if constexpr (Registry::has_indirect_vptr) {
+        if constexpr (Registry::has_compact_inplace_vptr) {
+            return Registry::class_vptrs[obj.boost_openmethod_vptr - 1];
+        } else if constexpr (Registry::has_indirect_vptr) {
             return *obj.boost_openmethod_vptr;
         } else {
             return obj.boost_openmethod_vptr;
@@ -147,12 +219,18 @@ class inplace_vptr_base : protected detail::inplace_vptr_base_tag {
     //! Set the vptr to `Class`\'s v-table.
     inplace_vptr_base() noexcept {
         (void)&detail::inplace_vptr_use_classes<Class, Registry>;
-        detail::boost_openmethod_update_vptr<Class>(static_cast<Class*>(this));
+
+        if constexpr (detail::stamps_inplace_vptr<Class, Registry>) {
+            detail::boost_openmethod_update_vptr<Class>(
+                static_cast<Class*>(this));
+        }
     }
 
     //! Set the vptr to `nullptr`.
     ~inplace_vptr_base() noexcept {
-        boost_openmethod_vptr = nullptr;
+        if constexpr (!Registry::has_final_inplace_vptr) {
+            boost_openmethod_vptr = {};
+        }
     }
 };
 
@@ -219,15 +297,22 @@ class inplace_vptr_derived<Class, Base> {
     //! Set the vptr to `Class`\'s v-table.
     inplace_vptr_derived() noexcept {
         using namespace detail;
-        (void)&detail::inplace_vptr_use_classes<
-            Class, Base, detail::inplace_vptr_registry<Class>>;
-        boost_openmethod_update_vptr<Class>(static_cast<Class*>(this));
+        using registry = inplace_vptr_registry<Class>;
+        (void)&detail::inplace_vptr_use_classes<Class, Base, registry>;
+
+        if constexpr (stamps_inplace_vptr<Class, registry>) {
+            boost_openmethod_update_vptr<Class>(static_cast<Class*>(this));
+        }
     }
 
     //! Set the vptr in base class.
     ~inplace_vptr_derived() noexcept {
-        detail::boost_openmethod_update_vptr<Base>(
-            static_cast<Base*>(static_cast<Class*>(this)));
+        using registry = detail::inplace_vptr_registry<Class>;
+
+        if constexpr (!registry::has_final_inplace_vptr) {
+            detail::boost_openmethod_update_vptr<Base>(
+                static_cast<Base*>(static_cast<Class*>(this)));
+        }
     }
 };
 
@@ -254,22 +339,32 @@ class inplace_vptr_derived<Class, Base1, Base2, MoreBases...> {
   protected:
     //! Set the vptr to `Class`\'s v-table.
     inplace_vptr_derived() noexcept {
+        using registry = detail::inplace_vptr_registry<Base1>;
         (void)&detail::inplace_vptr_use_classes<
-            Class, Base1, Base2, MoreBases...,
-            detail::inplace_vptr_registry<Base1>>;
-        detail::boost_openmethod_update_vptr<Class>(static_cast<Class*>(this));
+            Class, Base1, Base2, MoreBases..., registry>;
+
+        if constexpr (detail::stamps_inplace_vptr<Class, registry>) {
+            detail::boost_openmethod_update_vptr<Class>(
+                static_cast<Class*>(this));
+        }
     }
 
     //! Set the vptr in each base class.
     //!
     //! For each base, set its vptr to the base's v-table.
     ~inplace_vptr_derived() noexcept {
-        auto obj = static_cast<Class*>(this);
-        detail::boost_openmethod_update_vptr<Base1>(static_cast<Base1*>(obj));
-        detail::boost_openmethod_update_vptr<Base2>(static_cast<Base2*>(obj));
-        (detail::boost_openmethod_update_vptr<MoreBases>(
-             static_cast<MoreBases*>(obj)),
-         ...);
+        using registry = detail::inplace_vptr_registry<Base1>;
+
+        if constexpr (!registry::has_final_inplace_vptr) {
+            auto obj = static_cast<Class*>(this);
+            detail::boost_openmethod_update_vptr<Base1>(
+                static_cast<Base1*>(obj));
+            detail::boost_openmethod_update_vptr<Base2>(
+                static_cast<Base2*>(obj));
+            (detail::boost_openmethod_update_vptr<MoreBases>(
+                 static_cast<MoreBases*>(obj)),
+             ...);
+        }
     }
 };
 
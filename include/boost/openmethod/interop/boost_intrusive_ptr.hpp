@@ -50,8 +50,7 @@ struct virtual_traits<boost::intrusive_ptr<Class>, Registry> {
         if constexpr (detail::requires_dynamic_cast<Class*, element_type*>) {
             // make it work with custom RTTI
             return OverriderType(
-                &Registry::rtti::template dynamic_cast_ref<element_type&>(
-                    *obj));
+                &detail::cached_dynamic_cast<Registry, element_type&>(*obj));
         } else {
             return boost::static_pointer_cast<element_type>(obj);
         }
@@ -104,7 +103,7 @@ struct virtual_traits<const boost::intrusive_ptr<Class>&, Registry> {
                 // make it work with custom RTTI
                 return std::remove_const_t<
                     std::remove_reference_t<OverriderType>>(
-                    &Registry::rtti::template dynamic_cast_ref<element_type&>(
+                    &detail::cached_dynamic_cast<Registry, element_type&>(
                         *obj));
             } else {
                 return boost::static_pointer_cast<element_type>(obj);
@@ -113,6 +112,133 @@ struct virtual_traits<const boost::intrusive_ptr<Class>&, Registry> {
     }
 };
 
+//! Non-owning view of an object managed by a `boost::intrusive_ptr`.
+//!
+//! A `borrowed_intrusive_ptr` points to an object managed by
+//! `boost::intrusive_ptr`s, without touching its reference count. Used as a
+//! virtual parameter type, it passes the object from method to overrider
+//! without the increments and decrements that casting a
+//! `boost::intrusive_ptr` entails.
+//!
+//! A `borrowed_intrusive_ptr` must not outlive the `boost::intrusive_ptr` it
+//! is constructed from. To retain the object, the overrider must call
+//! `share`.
+//!
+//! @tparam Class A class type, possibly cv-qualified.
+template<class Class>
+class borrowed_intrusive_ptr {
+    Class* ptr;
+
+  public:
+    //! Class
+    using element_type = Class;
+
+    //! Construct from a pointer
+    //!
+    //! @param ptr A pointer to an object managed by `boost::intrusive_ptr`s.
+    explicit borrowed_intrusive_ptr(Class* ptr) : ptr(ptr) {
+    }
+
+    //! Construct from a `boost::intrusive_ptr`
+    //!
+    //! @param owner A `boost::intrusive_ptr` to an object of a class
+    //! convertible to `Class`.
+    template<
+        class Other,
+        typename = std::enable_if_t<std::is_convertible_v<Other*, Class*>>>
+    borrowed_intrusive_ptr(const boost::intrusive_ptr<Other>& owner)
+        : ptr(owner.get()) {
+    }
+
+    //! Construct from a `borrowed_intrusive_ptr` to a convertible class
+    //!
+    //! @param other A `borrowed_intrusive_ptr` to an object of a class
+    //! convertible to `Class`.
+    template<
+        class Other,
+        typename = std::enable_if_t<std::is_convertible_v<Other*, Class*>>>
+    borrowed_intrusive_ptr(const borrowed_intrusive_ptr<Other>& other)
+        : ptr(other.get()) {
+    }
+
+    //! Get a pointer to the object
+    //!
+    //! @return A pointer to the object
+    auto get() const -> Class* {
+        return ptr;
+    }
+
+    //! Get a pointer to the object
+    //!
+    //! @return A pointer to the object
+    auto operator->() const -> Class* {
+        return ptr;
+    }
+
+    //! Get a reference to the object
+    //!
+    //! @return A reference to the object
+    auto operator*() const -> Class& {
+        return *ptr;
+    }
+
+    //! Test if the pointer is non-null
+    explicit operator bool() const {
+        return ptr != nullptr;
+    }
+
+    //! Return a `boost::intrusive_ptr` to the object
+    //!
+    //! This is the only operation that updates the reference count.
+    //!
+    //! @return A `boost::intrusive_ptr<Class>` to the object.
+    auto share() const -> boost::intrusive_ptr<Class> {
+        return boost::intrusive_ptr<Class>(ptr);
+    }
+};
+
+//! Specialize virtual_traits for borrowed_intrusive_ptr by value.
+//!
+//! @tparam Class A class type, possibly cv-qualified.
+//! @tparam Registry A @ref registry.
+template<class Class, class Registry>
+struct virtual_traits<borrowed_intrusive_ptr<Class>, Registry> {
+    //! `Class`, stripped from cv-qualifiers.
+    using virtual_type = std::remove_cv_t<Class>;
+
+    //! Return a reference to a non-modifiable `Class` object.
+    //! @param arg A reference to a `borrowed_intrusive_ptr<Class>`.
+    //! @return A reference to the object pointed to.
+    static auto peek(const borrowed_intrusive_ptr<Class>& arg)
+        -> const Class& {
+        return *arg;
+    }
+
+    //! Cast method argument to overrider argument.
+    //!
+    //! Cast to a `borrowed_intrusive_ptr` to a derived class, using a static
+    //! cast if possible, and a dynamic cast otherwise. The reference count is
+    //! not updated.
+    //!
+    //! @tparam OverriderType A `borrowed_intrusive_ptr` type, or a const
+    //! reference to one.
+    //! @param obj The method's argument.
+    //! @return A `borrowed_intrusive_ptr` _value_.
+    template<class OverriderType>
+    static auto cast(const borrowed_intrusive_ptr<Class>& obj) {
+        using element_type =
+            typename std::remove_reference_t<OverriderType>::element_type;
+
+        if constexpr (detail::requires_dynamic_cast<Class*, element_type*>) {
+            return borrowed_intrusive_ptr<element_type>(
+                &detail::cached_dynamic_cast<Registry, element_type&>(*obj));
+        } else {
+            return borrowed_intrusive_ptr<element_type>(
+                static_cast<element_type*>(obj.get()));
+        }
+    }
+};
+
 //! Alias for a `virtual_ptr<boost::intrusive_ptr<T>>`.
 template<class Class, class Registry = BOOST_OPENMETHOD_DEFAULT_REGISTRY>
 using boost_intrusive_virtual_ptr =
@@ -141,6 +267,7 @@ inline auto make_boost_intrusive_virtual(T&&... args) {
 }
 
 namespace aliases {
+using boost::openmethod::borrowed_intrusive_ptr;
 using boost::openmethod::boost_intrusive_virtual_ptr;
 using boost::openmethod::make_boost_intrusive_virtual;
 } // namespace aliases
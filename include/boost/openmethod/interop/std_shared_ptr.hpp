@@ -7,6 +7,8 @@
 #define BOOST_OPENMETHOD_INTEROP_SHARED_PTR_HPP
 
 #include <boost/openmethod/core.hpp>
+#include <boost/openmethod/detail/allocator.hpp>
+
 #include <memory>
 
 namespace boost::openmethod {
@@ -49,6 +51,15 @@ struct validate_method_parameter<
         "std::shared_ptr cannot be passed by non-const lvalue reference");
 };
 
+// Return a `std::shared_ptr` that shares ownership with `*owner`, a
+// `std::shared_ptr<Owner>`, and points to `ptr`.
+template<class Owner>
+auto share_borrowed(const void* owner, const volatile void* ptr)
+    -> std::shared_ptr<const volatile void> {
+    return std::shared_ptr<const volatile void>(
+        *static_cast<const std::shared_ptr<Owner>*>(owner), ptr);
+}
+
 } // namespace detail
 
 //! Specialize virtual_traits for std::shared_ptr by value.
@@ -76,7 +87,8 @@ struct virtual_traits<std::shared_ptr<Class>, Registry> {
     //! Cast to another type.
     //!
     //! Cast to a `std::shared_ptr` to another type. If possible, use
-    //! `std::static_pointer_cast`. Otherwise, use `std::dynamic_pointer_cast`.
+    //! `std::static_pointer_cast`. Otherwise, use the aliasing constructor,
+    //! with the managed object cast by `Registry::rtti::dynamic_cast_ref`.
     //!
     //! @tparam Derived A lvalue reference type to a `std::shared_ptr`.
     //! @param obj A reference to a `const shared_ptr<Class>`.
@@ -88,8 +100,11 @@ struct virtual_traits<std::shared_ptr<Class>, Registry> {
 
         if constexpr (requires_dynamic_cast<
                           Class*, typename Derived::element_type*>) {
-            return std::dynamic_pointer_cast<
-                typename shared_ptr_cast_traits<Derived>::virtual_type>(obj);
+            using derived_type =
+                typename shared_ptr_cast_traits<Derived>::virtual_type;
+
+            return std::shared_ptr<derived_type>(
+                obj, &cached_dynamic_cast<Registry, derived_type&>(*obj));
         } else {
             return std::static_pointer_cast<
                 typename shared_ptr_cast_traits<Derived>::virtual_type>(obj);
@@ -100,12 +115,13 @@ struct virtual_traits<std::shared_ptr<Class>, Registry> {
     //! Move-cast to another type (since c++20)
     //!
     //! Cast to a `std::shared_ptr` xvalue reference to another type. If
-    //! possible, use `std::static_pointer_cast`. Otherwise, use
-    //! `std::dynamic_pointer_cast`.
+    //! possible, use `std::static_pointer_cast`. Otherwise, use the aliasing
+    //! constructor, with the managed object cast by
+    //! `Registry::rtti::dynamic_cast_ref`.
     //!
     //! @note This overload is only available for C++20 and above, because
-    //! rvalue references overloads of `std::static_pointer_cast` and
-    //! `std::dynamic_pointer_cast` were not available before.
+    //! rvalue references overloads of `std::static_pointer_cast` and of the
+    //! aliasing constructor were not available before.
     //!
     //! @tparam Derived A xvalue reference to a `std::shared_ptr`.
     //! @param obj A xvalue reference to a `shared_ptr<Class>`.
@@ -117,9 +133,11 @@ struct virtual_traits<std::shared_ptr<Class>, Registry> {
 
         if constexpr (requires_dynamic_cast<
                           Class*, decltype(std::declval<Derived>().get())>) {
-            return std::dynamic_pointer_cast<
-                typename shared_ptr_cast_traits<Derived>::virtual_type>(
-                std::move(obj));
+            using derived_type =
+                typename shared_ptr_cast_traits<Derived>::virtual_type;
+            auto p = &cached_dynamic_cast<Registry, derived_type&>(*obj);
+
+            return std::shared_ptr<derived_type>(std::move(obj), p);
         } else {
             return std::static_pointer_cast<
                 typename shared_ptr_cast_traits<Derived>::virtual_type>(
@@ -134,7 +152,8 @@ struct virtual_traits<std::shared_ptr<Class>, Registry> {
 //! @note Passing a `std::shared_ptr` in a method call by const reference
 //! creates a temporary `std::shared_ptr` and passes it by const reference to
 //! the overrider. This is necessary because virtual arguments need to be cast
-//! to the type expected by the overrider.
+//! to the type expected by the overrider. Use @ref borrowed_shared_ptr to
+//! avoid updating the reference count.
 //!
 //! @tparam Class A class type, possibly cv-qualified.
 //! @tparam Registry A @ref registry.
@@ -160,7 +179,8 @@ struct virtual_traits<const std::shared_ptr<Class>&, Registry> {
     //! Cast to another type.
     //!
     //! Cast to a `std::shared_ptr` to another type. If possible, use
-    //! `std::static_pointer_cast`. Otherwise, use `std::dynamic_pointer_cast`.
+    //! `std::static_pointer_cast`. Otherwise, use the aliasing constructor,
+    //! with the managed object cast by `Registry::rtti::dynamic_cast_ref`.
     //!
     //! @tparam Derived A lvalue reference type to a `std::shared_ptr`.
     //! @param obj A reference to a `const shared_ptr<Class>`.
@@ -175,8 +195,11 @@ struct virtual_traits<const std::shared_ptr<Class>&, Registry> {
             using namespace boost::openmethod::detail;
 
             if constexpr (requires_dynamic_cast<Class*, Other>) {
-                return std::dynamic_pointer_cast<
-                    typename shared_ptr_cast_traits<Other>::virtual_type>(obj);
+                using derived_type =
+                    typename shared_ptr_cast_traits<Other>::virtual_type;
+
+                return std::shared_ptr<derived_type>(
+                    obj, &cached_dynamic_cast<Registry, derived_type&>(*obj));
             } else {
                 return std::static_pointer_cast<
                     typename shared_ptr_cast_traits<Other>::virtual_type>(obj);
@@ -185,6 +208,203 @@ struct virtual_traits<const std::shared_ptr<Class>&, Registry> {
     }
 };
 
+//! Non-owning view of an object managed by a `std::shared_ptr`.
+//!
+//! A `borrowed_shared_ptr` refers to an object, and to the `std::shared_ptr`
+//! that owns it, without touching the reference count. Used as a virtual
+//! parameter type, it passes objects managed by `std::shared_ptr`s from
+//! method to overrider without the atomic increments and decrements that
+//! casting a `std::shared_ptr` entails.
+//!
+//! Like `std::string_view`, a `borrowed_shared_ptr` must not outlive the
+//! `std::shared_ptr` it is constructed from. To prevent an overrider from
+//! retaining it, a `borrowed_shared_ptr` cannot be copied, moved or assigned,
+//! except by the dispatch mechanism. It can be converted to a
+//! `borrowed_shared_ptr` to a base class, but only from an rvalue, e.g. via an
+//! explicit `std::move`. To retain the object, the overrider must call
+//! `share`, which returns a `std::shared_ptr` that shares ownership with the
+//! original one. For the same reason, an overrider cannot pass its
+//! `borrowed_shared_ptr` argument to `next`.
+//!
+//! @par Example
+//! @code
+//! BOOST_OPENMETHOD(
+//!     poke, (virtual_<borrowed_shared_ptr<Animal>>), void);
+//!
+//! BOOST_OPENMETHOD_OVERRIDE(poke, (borrowed_shared_ptr<Dog> dog), void) {
+//!     // no reference count update
+//! }
+//!
+//! auto snoopy = std::make_shared<Dog>();
+//! poke(snoopy);
+//! @endcode
+//!
+//! @tparam Class A class type, possibly cv-qualified.
+template<class Class>
+class borrowed_shared_ptr {
+    template<class>
+    friend class borrowed_shared_ptr;
+    template<typename, class>
+    friend struct virtual_traits;
+    template<typename, typename, class>
+    friend class method;
+
+    using owner_type = std::shared_ptr<const volatile void>;
+
+    Class* ptr;
+    const void* owner;
+    owner_type (*share_owner)(const void*, const volatile void*);
+
+    // If `owner` is a `std::shared_ptr<Owner>`, return a `std::shared_ptr`
+    // that shares its ownership, and points to `ptr`.
+    template<class Owner>
+    auto share_if() const -> std::shared_ptr<Class> {
+        if (share_owner != &detail::share_borrowed<Owner>) {
+            return nullptr;
+        }
+
+        return std::shared_ptr<Class>(
+            *static_cast<const std::shared_ptr<Owner>*>(owner), ptr);
+    }
+
+    borrowed_shared_ptr(const borrowed_shared_ptr&) = default;
+
+    // Aliasing constructor: point to `ptr`, typically a cast of the object
+    // pointed to by `other`, and share the owner of `other`.
+    template<class Other>
+    borrowed_shared_ptr(const borrowed_shared_ptr<Other>& other, Class* ptr)
+        : ptr(ptr), owner(other.owner), share_owner(other.share_owner) {
+    }
+
+  public:
+    //! Class
+    using element_type = Class;
+
+    //! Construct from a `std::shared_ptr`
+    //!
+    //! @param owner A `std::shared_ptr` to an object of a class convertible to
+    //! `Class`.
+    template<
+        class Other,
+        typename = std::enable_if_t<std::is_convertible_v<Other*, Class*>>>
+    borrowed_shared_ptr(const std::shared_ptr<Other>& owner)
+        : ptr(owner.get()), owner(&owner),
+          share_owner(&detail::share_borrowed<Other>) {
+    }
+
+    //! Construct from a `borrowed_shared_ptr` rvalue to a convertible class
+    //!
+    //! Only rvalues are accepted, so that an overrider cannot retain its
+    //! argument by accident.
+    //!
+    //! @param other A `borrowed_shared_ptr` to an object of a class
+    //! convertible to `Class`.
+    template<
+        class Other,
+        typename = std::enable_if_t<
+            !std::is_same_v<Other, Class> &&
+            std::is_convertible_v<Other*, Class*>>>
+    borrowed_shared_ptr(borrowed_shared_ptr<Other>&& other)
+        : ptr(other.ptr), owner(other.owner), share_owner(other.share_owner) {
+    }
+
+    borrowed_shared_ptr& operator=(const borrowed_shared_ptr&) = delete;
+
+    //! Get a pointer to the object
+    //!
+    //! @return A pointer to the object
+    auto get() const -> Class* {
+        return ptr;
+    }
+
+    //! Get a pointer to the object
+    //!
+    //! @return A pointer to the object
+    auto operator->() const -> Class* {
+        return ptr;
+    }
+
+    //! Get a reference to the object
+    //!
+    //! @return A reference to the object
+    auto operator*() const -> Class& {
+        return *ptr;
+    }
+
+    //! Test if the pointer is non-null
+    explicit operator bool() const {
+        return ptr != nullptr;
+    }
+
+    //! Return a `std::shared_ptr` that shares ownership of the object
+    //!
+    //! This is the only operation that updates the reference count. If the
+    //! `std::shared_ptr` the view was constructed from points to a `Class`,
+    //! possibly non-const, the count is incremented once. Otherwise, the
+    //! owner's type is not known here, and the result is obtained via a
+    //! `std::shared_ptr<const volatile void>`, which, before C++20, costs one
+    //! more increment and decrement.
+    //!
+    //! @return A `std::shared_ptr<Class>` to the object, sharing ownership
+    //! with the `std::shared_ptr` the view was constructed from.
+    auto share() const -> std::shared_ptr<Class> {
+        if (auto result = share_if<std::remove_const_t<Class>>()) {
+            return result;
+        }
+
+        if constexpr (std::is_const_v<Class>) {
+            if (auto result = share_if<Class>()) {
+                return result;
+            }
+        }
+
+        return std::shared_ptr<Class>(share_owner(owner, ptr), ptr);
+    }
+};
+
+//! Specialize virtual_traits for borrowed_shared_ptr by value.
+//!
+//! @tparam Class A class type, possibly cv-qualified.
+//! @tparam Registry A @ref registry.
+template<class Class, class Registry>
+struct virtual_traits<borrowed_shared_ptr<Class>, Registry> {
+    //! `Class`, stripped from cv-qualifiers.
+    using virtual_type = std::remove_cv_t<Class>;
+
+    //! Return a reference to a non-modifiable `Class` object.
+    //! @param arg A reference to a `borrowed_shared_ptr<Class>`.
+    //! @return A reference to the object pointed to.
+    static auto peek(const borrowed_shared_ptr<Class>& arg) -> const Class& {
+        return *arg;
+    }
+
+    //! Cast to another type.
+    //!
+    //! Cast to a `borrowed_shared_ptr` to another type, using `static_cast`
+    //! if possible, and `Registry::rtti::dynamic_cast_ref` otherwise. The
+    //! result shares the owner of `obj`; the reference count is not updated.
+    //!
+    //! @tparam Derived A `borrowed_shared_ptr` type, or a const reference to
+    //! one.
+    //! @param obj A reference to a `const borrowed_shared_ptr<Class>`.
+    //! @return A `borrowed_shared_ptr` to the same object, cast to
+    //! `Derived::element_type`.
+    template<class Derived>
+    static auto cast(const borrowed_shared_ptr<Class>& obj) {
+        using element_type =
+            typename std::remove_reference_t<Derived>::element_type;
+
+        if constexpr (detail::requires_dynamic_cast<Class*, element_type*>) {
+            return borrowed_shared_ptr<element_type>(
+                obj,
+                &detail::cached_dynamic_cast<Registry, element_type&>(*obj));
+        } else {
+            return borrowed_shared_ptr<element_type>(
+                obj, static_cast<element_type*>(obj.get()));
+        }
+    }
+};
+
 //! Alias for a `virtual_ptr<std::shared_ptr<T>>`.
 template<class Class, class Registry = BOOST_OPENMETHOD_DEFAULT_REGISTRY>
 using shared_virtual_ptr = virtual_ptr<std::shared_ptr<Class>, Registry>;
@@ -211,7 +431,35 @@ inline auto make_shared_virtual(T&&... args) {
         std::make_shared<Class>(std::forward<T>(args)...));
 }
 
+//! Create a new object with an allocator and return a `shared_virtual_ptr` to
+//! it.
+//!
+//! Create an object using `std::allocate_shared`, and return a @ref
+//! shared_virtual_ptr pointing to it. Since the exact class of the object is
+//! known, the `virtual_ptr` is created using @ref final_virtual_ptr.
+//!
+//! `alloc` may be an allocator, or a pointer to a `std::pmr::memory_resource`,
+//! in which case a `std::pmr::polymorphic_allocator<std::byte>` is used.
+//!
+//! @tparam Class The class of the object to create.
+//! @tparam Registry A @ref registry.
+//! @tparam Allocator An allocator, or a pointer to a memory resource.
+//! @tparam T Types of the arguments to pass to the constructor of `Class`.
+//! @param alloc The allocator or the memory resource.
+//! @param args Arguments to pass to the constructor of `Class`.
+//! @return A `shared_virtual_ptr<Class, Registry>` pointing to a newly
+//! created object of type `Class`.
+template<
+    class Class, class Registry = BOOST_OPENMETHOD_DEFAULT_REGISTRY,
+    class Allocator, typename... T>
+inline auto allocate_shared_virtual(const Allocator& alloc, T&&... args) {
+    return final_virtual_ptr<Registry>(std::allocate_shared<Class>(
+        detail::as_allocator(alloc), std::forward<T>(args)...));
+}
+
 namespace aliases {
+using boost::openmethod::allocate_shared_virtual;
+using boost::openmethod::borrowed_shared_ptr;
 using boost::openmethod::make_shared_virtual;
 using boost::openmethod::shared_virtual_ptr;
 } // namespace aliases
@@ -7,8 +7,10 @@
 #define BOOST_OPENMETHOD_INTEROP_UNIQUE_PTR_HPP
 
 #include <boost/openmethod/core.hpp>
+#include <boost/openmethod/detail/allocator.hpp>
 
 #include <memory>
+#include <utility>
 
 namespace boost::openmethod {
 
@@ -41,8 +43,8 @@ struct virtual_traits<std::unique_ptr<Class>, Registry> {
     template<typename Derived>
     static auto cast(std::unique_ptr<Class>&& ptr) {
         if constexpr (detail::requires_dynamic_cast<Class&, Derived&>) {
-            auto p = &Registry::rtti::template dynamic_cast_ref<
-                typename Derived::element_type&>(*ptr);
+            auto p = &detail::cached_dynamic_cast<
+                Registry, typename Derived::element_type&>(*ptr);
             // coverity[alloc_fn]
             ptr.release();
             return Derived(p);
@@ -87,7 +89,184 @@ inline auto make_unique_virtual(T&&... args) {
         std::make_unique<Class>(std::forward<T>(args)...));
 }
 
+//! Deleter for objects created by @ref allocate_unique_virtual.
+//!
+//! `allocator_delete` destroys and deallocates an object with a copy of the
+//! allocator that created it. It remembers the class of the object, so it can
+//! delete it via a pointer to a base class. It converts implicitly to an
+//! `allocator_delete` for a base class, and explicitly to an
+//! `allocator_delete` for a derived class.
+//!
+//! @tparam Class The class of the objects to delete, possibly cv-qualified.
+//! @tparam Allocator An allocator.
+template<class Class, class Allocator>
+class allocator_delete {
+    template<class, class>
+    friend class allocator_delete;
+
+    Allocator alloc;
+    void (*destroy)(Allocator&, void*) = nullptr;
+
+    template<class Object>
+    static auto destroy_aux(Allocator& alloc, void* obj) -> void {
+        using traits = typename std::allocator_traits<
+            Allocator>::template rebind_traits<Object>;
+        typename traits::allocator_type object_alloc(alloc);
+        auto p = static_cast<Object*>(obj);
+        traits::destroy(object_alloc, p);
+        traits::deallocate(object_alloc, p, 1);
+    }
+
+  public:
+    //! Default constructor.
+    allocator_delete() = default;
+
+    //! Construct a deleter for objects of class `Object`.
+    //!
+    //! @tparam Object The class of the objects, `Class` or a class derived
+    //! from it, without cv-qualifiers.
+    //! @param alloc The allocator that creates the objects.
+    template<class Object>
+    allocator_delete(const Allocator& alloc, std::in_place_type_t<Object>)
+        : alloc(alloc), destroy(&destroy_aux<Object>) {
+    }
+
+    //! Construct from a deleter for a derived class.
+    //!
+    //! @param other An `allocator_delete` for a class convertible to
+    //! `Class`.
+    template<
+        class Other,
+        std::enable_if_t<std::is_convertible_v<Other*, Class*>, int> = 0>
+    allocator_delete(const allocator_delete<Other, Allocator>& other)
+        : alloc(other.alloc), destroy(other.destroy) {
+    }
+
+    //! Construct from a deleter for a base class.
+    //!
+    //! @param other An `allocator_delete` for a class that `Class` converts
+    //! to.
+    template<
+        class Other,
+        std::enable_if_t<!std::is_convertible_v<Other*, Class*>, int> = 0>
+    explicit allocator_delete(const allocator_delete<Other, Allocator>& other)
+        : alloc(other.alloc), destroy(other.destroy) {
+    }
+
+    //! Destroy and deallocate an object.
+    //!
+    //! @param obj A pointer to the object.
+    auto operator()(Class* obj) -> void {
+        if constexpr (std::is_polymorphic_v<Class>) {
+            destroy(
+                alloc,
+                const_cast<void*>(dynamic_cast<const volatile void*>(obj)));
+        } else {
+            destroy(alloc, const_cast<std::remove_cv_t<Class>*>(obj));
+        }
+    }
+};
+
+//! Specialize virtual_traits for std::unique_ptr with an allocator_delete.
+//!
+//! @tparam Class A class type, possibly cv-qualified.
+//! @tparam Allocator An allocator.
+//! @tparam Registry A @ref registry.
+template<class Class, class Allocator, class Registry>
+struct virtual_traits<
+    std::unique_ptr<Class, allocator_delete<Class, Allocator>>, Registry> {
+    //! `Class`, stripped from cv-qualifiers.
+    using virtual_type = std::remove_cv_t<Class>;
+
+    //! Return a reference to a non-modifiable `Class` object.
+    //! @param arg A reference to a `std::unique_ptr`.
+    //! @return A reference to the object pointed to.
+    static auto peek(
+        const std::unique_ptr<Class, allocator_delete<Class, Allocator>>& arg)
+        -> const Class& {
+        return *arg;
+    }
+
+    //! Cast to a type.
+    //!
+    //! Same as for `std::unique_ptr` with the default deleter. The deleter is
+    //! converted to the target type.
+    //!
+    //! @tparam Derived A `std::unique_ptr` type.
+    //! @param obj A xvalue reference to a `std::unique_ptr`.
+    //! @return A `Derived`.
+    template<typename Derived>
+    static auto
+    cast(std::unique_ptr<Class, allocator_delete<Class, Allocator>>&& ptr) {
+        using element_type = typename Derived::element_type;
+        element_type* p;
+
+        if constexpr (detail::requires_dynamic_cast<Class&, element_type&>) {
+            p = &detail::cached_dynamic_cast<Registry, element_type&>(*ptr);
+        } else {
+            p = &static_cast<element_type&>(*ptr);
+        }
+
+        typename Derived::deleter_type deleter(ptr.get_deleter());
+        // coverity[alloc_fn]
+        ptr.release();
+
+        return Derived(p, std::move(deleter));
+    }
+
+    //! Rebind to a different element type.
+    //!
+    //! @tparam Other The new element type.
+    template<class Other>
+    using rebind = std::unique_ptr<Other, allocator_delete<Other, Allocator>>;
+};
+
+//! Create a new object with an allocator and return a `virtual_ptr` to it.
+//!
+//! Create an object using `alloc`, and return a @ref virtual_ptr to a
+//! `std::unique_ptr` that owns it, with an @ref allocator_delete deleter.
+//! Since the exact class of the object is known, the `virtual_ptr` is created
+//! using @ref final_virtual_ptr.
+//!
+//! `alloc` may be an allocator, or a pointer to a `std::pmr::memory_resource`,
+//! in which case a `std::pmr::polymorphic_allocator<std::byte>` is used.
+//!
+//! @tparam Class The class of the object to create.
+//! @tparam Registry A @ref registry.
+//! @tparam Allocator An allocator, or a pointer to a memory resource.
+//! @tparam T Types of the arguments to pass to the constructor of `Class`.
+//! @param alloc The allocator or the memory resource.
+//! @param args Arguments to pass to the constructor of `Class`.
+//! @return A `virtual_ptr<std::unique_ptr<Class, allocator_delete<Class,
+//! A>>, Registry>`, where `A` is the allocator.
+template<
+    class Class, class Registry = BOOST_OPENMETHOD_DEFAULT_REGISTRY,
+    class Allocator, typename... T>
+inline auto allocate_unique_virtual(const Allocator& alloc, T&&... args) {
+    auto base_alloc = detail::as_allocator(alloc);
+    using base_allocator = decltype(base_alloc);
+    using object_type = std::remove_cv_t<Class>;
+    using traits = typename std::allocator_traits<
+        base_allocator>::template rebind_traits<object_type>;
+    typename traits::allocator_type object_alloc(base_alloc);
+    object_type* p = traits::allocate(object_alloc, 1);
+
+    try {
+        traits::construct(object_alloc, p, std::forward<T>(args)...);
+    } catch (...) {
+        traits::deallocate(object_alloc, p, 1);
+        throw;
+    }
+
+    return final_virtual_ptr<Registry>(
+        std::unique_ptr<Class, allocator_delete<Class, base_allocator>>(
+            p,
+            allocator_delete<Class, base_allocator>(
+                base_alloc, std::in_place_type<object_type>)));
+}
+
 namespace aliases {
+using boost::openmethod::allocate_unique_virtual;
 using boost::openmethod::make_unique_virtual;
 using boost::openmethod::unique_virtual_ptr;
 } // namespace aliases
@@ -0,0 +1,154 @@
+// Copyright (c) 2018-2025 Jean-Louis Leroy
+// Distributed under the Boost Software License, Version 1.0.
+// See accompanying file LICENSE_1_0.txt
+// or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_OPENMETHOD_LOCAL_POOL_ALLOCATOR_HPP
+#define BOOST_OPENMETHOD_LOCAL_POOL_ALLOCATOR_HPP
+
+#include <cstddef>
+#include <new>
+
+namespace boost::openmethod {
+
+namespace detail {
+
+// A thread-local free list of blocks of `Size` bytes, aligned on `Align`.
+template<std::size_t Size, std::size_t Align>
+class local_pool {
+    struct block {
+        block* next;
+    };
+
+    block* free_list = nullptr;
+
+    local_pool() = default;
+
+  public:
+    local_pool(const local_pool&) = delete;
+    auto operator=(const local_pool&) -> local_pool& = delete;
+
+    ~local_pool() {
+        while (free_list) {
+            auto next = free_list->next;
+            ::operator delete(free_list, std::align_val_t(Align));
+            free_list = next;
+        }
+    }
+
+    static auto instance() -> local_pool& {
+        static thread_local local_pool pool;
+
+        return pool;
+    }
+
+    auto allocate() -> void* {
+        if (auto p = free_list) {
+            free_list = p->next;
+
+            return p;
+        }
+
+        return ::operator new(Size, std::align_val_t(Align));
+    }
+
+    auto deallocate(void* p) -> void {
+        auto b = static_cast<block*>(p);
+        b->next = free_list;
+        free_list = b;
+    }
+};
+
+} // namespace detail
+
+//! Allocator that recycles single objects via a thread-local free list.
+//!
+//! `local_pool_allocator` keeps, for each thread, a free list of blocks for
+//! each size class. The size class is determined by the size and alignment of
+//! `T`, rounded up to a multiple of the default new alignment. Allocating and
+//! deallocating a single object pops and pushes a block from the list of the
+//! calling thread, without locking. Arrays are allocated with `operator new`.
+//!
+//! Blocks are never returned to the global heap while the thread is running.
+//! They are released when the thread exits. A block deallocated by a thread
+//! other than the one that allocated it joins the free list of the
+//! deallocating thread. Objects must not be deallocated by a thread after its
+//! thread-local variables have been destroyed, e.g. from the destructors of
+//! static objects.
+//!
+//! `local_pool_allocator` is stateless: all instances compare equal. It is
+//! designed for @ref allocate_shared_virtual and @ref
+//! allocate_unique_virtual, which know the exact class of the object, and
+//! thus its size class, at the call.
+//!
+//! @tparam T The type of the objects to allocate.
+template<class T>
+class local_pool_allocator {
+    static constexpr std::size_t granularity =
+        __STDCPP_DEFAULT_NEW_ALIGNMENT__;
+    static constexpr std::size_t align =
+        alignof(T) > granularity ? alignof(T) : granularity;
+    static constexpr std::size_t size =
+        (sizeof(T) + align - 1) / align * align;
+
+    using pool = detail::local_pool<size, align>;
+
+  public:
+    //! The type of the objects to allocate.
+    using value_type = T;
+
+    //! Default constructor.
+    local_pool_allocator() = default;
+
+    //! Construct from an allocator for another type.
+    template<class U>
+    local_pool_allocator(const local_pool_allocator<U>&) {
+    }
+
+    //! Allocate storage for `n` objects.
+    //!
+    //! @param n The number of objects.
+    //! @return A pointer to the storage.
+    auto allocate(std::size_t n) -> T* {
+        if (n == 1) {
+            return static_cast<T*>(pool::instance().allocate());
+        }
+
+        return static_cast<T*>(
+            ::operator new(n * sizeof(T), std::align_val_t(align)));
+    }
+
+    //! Deallocate storage for `n` objects.
+    //!
+    //! @param p A pointer returned by `allocate`.
+    //! @param n The number of objects passed to `allocate`.
+    auto deallocate(T* p, std::size_t n) -> void {
+        if (n == 1) {
+            pool::instance().deallocate(p);
+        } else {
+            ::operator delete(p, std::align_val_t(align));
+        }
+    }
+};
+
+//! Compare two `local_pool_allocator`s.
+//!
+//! @return `true`.
+template<class T, class U>
+auto operator==(const local_pool_allocator<T>&, const local_pool_allocator<U>&)
+    -> bool {
+    return true;
+}
+
+//! Compare two `local_pool_allocator`s.
+//!
+//! @return `false`.
+template<class T, class U>
+auto operator!=(const local_pool_allocator<T>&, const local_pool_allocator<U>&)
+    -> bool {
+    return false;
+}
+
+} // namespace boost::openmethod
+
+#endif
@@ -0,0 +1,237 @@
+// Copyright (c) 2018-2025 Jean-Louis Leroy
+// Distributed under the Boost Software License, Version 1.0.
+// See accompanying file LICENSE_1_0.txt
+// or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_OPENMETHOD_PAGE_ARENA_HPP
+#define BOOST_OPENMETHOD_PAGE_ARENA_HPP
+
+#include <boost/openmethod/core.hpp>
+#include <boost/openmethod/policies/page_vptr.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <utility>
+#include <vector>
+
+namespace boost::openmethod {
+
+//! Allocates objects in pages segregated by class.
+//!
+//! `page_arena` allocates objects in pages of `PageSize` bytes, aligned on
+//! their size. All the objects in a page have the same class, and the page
+//! starts with a header that contains the address of the @ref
+//! registry::static_vptr of that class. The @ref page_vptr policy, with the
+//! same `PageSize`, finds the v-table pointer of an object by masking its
+//! address, without per-object storage or RTTI.
+//!
+//! Each class has its own pool of pages, and its own list of free slots.
+//! `new_object` finds the pool of the class via a per-class index, without
+//! hashing. Deleting an object returns its slot to the list of its class; pages
+//! are kept by the pool, and released when the arena is destroyed.
+//!
+//! `page_arena` is not thread-safe.
+//!
+//! @par Requirements
+//!
+//! @li The objects must be deleted, via `delete_object`, before the arena is
+//! destroyed; otherwise their destructors are not called.
+//! @li `Class` must fit in a page, after the header.
+//!
+//! @tparam Registry The registry in which the classes are registered.
+//! @tparam PageSize The size of the pages, a power of two.
+template<
+    class Registry = BOOST_OPENMETHOD_DEFAULT_REGISTRY,
+    std::size_t PageSize = std::size_t(64) << 10>
+class page_arena {
+    static_assert(
+        (PageSize & (PageSize - 1)) == 0, "PageSize must be a power of two");
+
+    struct pool;
+
+    struct page : detail::page_header {
+        pool* owner;
+        page* next;
+    };
+
+    struct pool {
+        std::size_t slot_size;
+        std::size_t first_slot;
+        std::size_t slots_per_page;
+        void* free_list = nullptr;
+    };
+
+    // Pools, indexed by `class_index`; null for the classes that this arena
+    // has not allocated yet.
+    std::vector<std::unique_ptr<pool>> pools;
+    page* pages = nullptr;
+    std::size_t pages_count = 0;
+    std::size_t objects_count = 0;
+
+    static constexpr auto round_up(std::size_t n, std::size_t alignment)
+        -> std::size_t {
+        return (n + alignment - 1) / alignment * alignment;
+    }
+
+    static inline std::atomic<std::size_t> classes_count{0};
+
+    // A small, dense number for each class allocated by any arena of this
+    // type.
+    template<class Class>
+    static auto class_index() -> std::size_t {
+        static const std::size_t index = classes_count++;
+
+        return index;
+    }
+
+    template<class Class>
+    auto pool_of() -> pool& {
+        constexpr auto alignment = alignof(Class) > alignof(void*)
+            ? alignof(Class)
+            : alignof(void*);
+        constexpr auto slot_size = round_up(
+            sizeof(Class) > sizeof(void*) ? sizeof(Class) : sizeof(void*),
+            alignment);
+        constexpr auto first_slot = round_up(sizeof(page), alignment);
+
+        static_assert(
+            first_slot + slot_size <= PageSize,
+            "Class does not fit in a page");
+
+        auto index = class_index<Class>();
+
+        if (index >= pools.size()) {
+            pools.resize(index + 1);
+        }
+
+        auto& owner = pools[index];
+
+        if (!owner) {
+            owner = std::make_unique<pool>();
+            owner->slot_size = slot_size;
+            owner->first_slot = first_slot;
+            owner->slots_per_page = (PageSize - first_slot) / slot_size;
+        }
+
+        return *owner;
+    }
+
+    auto add_page(pool& owner, const vptr_type* vptr) -> void {
+        auto pg = ::new (::operator new(PageSize, std::align_val_t(PageSize)))
+            page;
+        pg->tag = detail::page_tag(pg);
+        pg->vptr = vptr;
+        pg->owner = &owner;
+        pg->next = pages;
+        pages = pg;
+        ++pages_count;
+
+        // Thread the slots on the free list, so that they are handed out in
+        // address order.
+        auto first = reinterpret_cast<char*>(pg) + owner.first_slot;
+
+        for (auto i = owner.slots_per_page; i-- > 0;) {
+            auto slot = first + i * owner.slot_size;
+            *reinterpret_cast<void**>(slot) = owner.free_list;
+            owner.free_list = slot;
+        }
+    }
+
+  public:
+    //! The size of the pages.
+    static constexpr std::size_t page_size = PageSize;
+
+    page_arena() = default;
+    page_arena(const page_arena&) = delete;
+    auto operator=(const page_arena&) -> page_arena& = delete;
+
+    //! Release all the pages.
+    ~page_arena() {
+        while (pages) {
+            auto next = pages->next;
+            ::operator delete(pages, std::align_val_t(PageSize));
+            pages = next;
+        }
+    }
+
+    //! Create an object.
+    //!
+    //! Take a slot from the free list of `Class`, adding a page if it is
+    //! empty, and construct an object in it.
+    //!
+    //! @tparam Class The class of the object to create.
+    //! @tparam T Types of the arguments to pass to the constructor of `Class`.
+    //! @param args Arguments to pass to the constructor of `Class`.
+    //! @return A pointer to the new object.
+    template<class Class, typename... T>
+    auto new_object(T&&... args) -> Class* {
+        auto& owner = pool_of<Class>();
+
+        if (!owner.free_list) {
+            add_page(owner, &Registry::template static_vptr<Class>);
+        }
+
+        auto slot = owner.free_list;
+        owner.free_list = *static_cast<void**>(slot);
+        Class* result;
+
+        try {
+            result = ::new (slot) Class(std::forward<T>(args)...);
+        } catch (...) {
+            *static_cast<void**>(slot) = owner.free_list;
+            owner.free_list = slot;
+            throw;
+        }
+
+        ++objects_count;
+
+        return result;
+    }
+
+    //! Destroy an object created by `new_object`.
+    //!
+    //! Destroy the object, and return its slot to the free list of its
+    //! class.
+    //!
+    //! @tparam Class The class of the object, or a base class with a virtual
+    //! destructor.
+    //! @param obj A pointer to the object, or `nullptr`.
+    template<class Class>
+    auto delete_object(Class* obj) -> void {
+        if (!obj) {
+            return;
+        }
+
+        // Any sub-object lies in the same slot as the complete object.
+        auto address = static_cast<const void*>(obj);
+        auto pg = const_cast<page*>(
+            static_cast<const page*>(detail::page_of<PageSize>(address)));
+        auto& owner = *pg->owner;
+        auto first = reinterpret_cast<char*>(pg) + owner.first_slot;
+        auto index =
+            std::size_t(static_cast<const char*>(address) - first) /
+            owner.slot_size;
+        auto slot = first + index * owner.slot_size;
+
+        obj->~Class();
+        *reinterpret_cast<void**>(slot) = owner.free_list;
+        owner.free_list = slot;
+        --objects_count;
+    }
+
+    //! Return the number of live objects.
+    auto size() const -> std::size_t {
+        return objects_count;
+    }
+
+    //! Return the number of pages allocated.
+    auto page_count() const -> std::size_t {
+        return pages_count;
+    }
+};
+
+} // namespace boost::openmethod
+
+#endif
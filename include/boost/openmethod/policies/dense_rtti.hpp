@@ -0,0 +1,335 @@
+// Copyright (c) 2018-2025 Jean-Louis Leroy
+// Distributed under the Boost Software License, Version 1.0.
+// See accompanying file LICENSE_1_0.txt
+// or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_OPENMETHOD_POLICY_DENSE_RTTI_HPP
+#define BOOST_OPENMETHOD_POLICY_DENSE_RTTI_HPP
+
+#include <boost/openmethod/preamble.hpp>
+#include <boost/openmethod/policies/std_rtti.hpp>
+
+#include <boost/mp11/algorithm.hpp>
+
+#include <unordered_map>
+#include <vector>
+
+namespace boost::openmethod {
+
+namespace detail {
+
+template<class Class, class Registry, typename = void>
+struct has_dense_type_id_fn : std::false_type {};
+
+template<class Class, class Registry>
+struct has_dense_type_id_fn<
+    Class, Registry,
+    std::void_t<decltype(boost_openmethod_type_id(
+        std::declval<const Class&>(), std::declval<Registry*>()))>>
+    : std::true_type {};
+
+void boost_openmethod_dense_registry(...);
+void boost_openmethod_dense_bases(...);
+
+template<class Class>
+using dense_type_id_registry =
+    decltype(boost_openmethod_dense_registry(std::declval<Class*>()));
+
+template<class>
+struct set_dense_type_id_bases;
+
+template<class To, class Class>
+void set_dense_type_id(Class* obj);
+
+template<class... Bases>
+struct set_dense_type_id_bases<mp11::mp_list<Bases...>> {
+    template<class To, class Class>
+    static void fn(Class* obj) {
+        (set_dense_type_id<To>(static_cast<Bases*>(obj)), ...);
+    }
+};
+
+// Point the type id slot, in each root of `Class`, to the id of `To`.
+template<class To, class Class>
+void set_dense_type_id(Class* obj) {
+    using bases = decltype(boost_openmethod_dense_bases(obj));
+
+    if constexpr (mp11::mp_size<bases>::value == 0) {
+        using registry = dense_type_id_registry<Class>;
+        obj->boost_openmethod_dense_id = &registry::rtti::template id<To>;
+    } else {
+        set_dense_type_id_bases<bases>::template fn<To, Class>(obj);
+    }
+}
+
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic ignored "-Wnon-template-friend"
+#endif
+
+} // namespace detail
+
+namespace policies {
+
+//! Assigns dense, sequential type ids to classes.
+//!
+//! `dense_rtti` is an adapter that wraps another @ref rtti policy. It numbers
+//! the classes that store their type id - see below - starting at 1, in the
+//! order in which they are first passed to `static_type`. Since `dense_rtti`
+//! derives from @ref deferred_static_rtti, the numbering takes place during
+//! @ref initialize, following the order of registration. Other types, e.g.
+//! methods, keep the `type_id`s of `Rtti`, and are not numbered. The `type_id`s
+//! of the classes are small integers, suitable for indexing @ref vptr_vector
+//! directly, in a registry without a @ref type_hash policy.
+//!
+//! `dynamic_type` does not use `Rtti`, nor a hash table. It calls
+//! `boost_openmethod_type_id(const Class&, Registry*)`, found via ADL, which
+//! must return the id stored in the object. The @ref dense_type_id_base and
+//! @ref dense_type_id_derived mixins provide this function. Alternatively,
+//! the id can be stored in a member set to
+//! `Registry::rtti::static_type<Class>()` by each constructor.
+//!
+//! @tparam Rtti The underlying @ref rtti policy.
+template<class Rtti = std_rtti>
+struct dense_rtti : deferred_static_rtti {
+    //! A RttiFn metafunction.
+    //!
+    //! @tparam Registry The registry containing this policy.
+    template<class Registry>
+    struct fn {
+        using base_rtti = typename Rtti::template fn<Registry>;
+        using type_index_type = decltype(base_rtti::type_index(nullptr));
+
+      private:
+        // The id of the classes that are not numbered yet.
+        static constexpr auto unassigned = ~std::size_t(0);
+
+        struct state {
+            // dense id -> underlying type_id, index 0 is not used
+            std::vector<type_id> types{nullptr};
+            // underlying type_index -> dense id; used only by static_type
+            std::unordered_map<type_index_type, std::size_t> ids;
+        };
+
+        // Function-local static, because ids may be assigned during static
+        // construction.
+        static auto data() -> state& {
+            static state instance;
+
+            return instance;
+        }
+
+        template<class Class>
+        static auto assign() -> type_id {
+            auto& [types, ids] = data();
+            auto type = base_rtti::template static_type<Class>();
+            auto [iter, inserted] =
+                ids.emplace(base_rtti::type_index(type), types.size());
+
+            if (inserted) {
+                types.push_back(type);
+            }
+
+            id<Class> = type_id(iter->second);
+
+            return id<Class>;
+        }
+
+      public:
+        //! The dense id of a class, read by @ref dense_type_id_base.
+        //!
+        //! Set by `static_type<Class>()`. Until then, it contains an id that
+        //! is out of the range of the assigned ids.
+        //!
+        //! @tparam Class A class.
+        template<class Class>
+        static inline type_id id = type_id(unassigned);
+
+        //! Tests if a class is polymorphic.
+        //!
+        //! Forwards to `Rtti`.
+        //!
+        //! @tparam Class A class.
+        template<class Class>
+        static constexpr bool is_polymorphic =
+            base_rtti::template is_polymorphic<Class>;
+
+        //! Returns the @ref type_id of a type.
+        //!
+        //! If `Class` stores its type id, returns its dense id, assigning the
+        //! next available id the first time it is called for that type.
+        //! Otherwise, forwards to `Rtti`.
+        //!
+        //! @tparam Class A class.
+        //! @return The static type_id of Class.
+        template<class Class>
+        static auto static_type() -> type_id {
+            using stores_id = detail::has_dense_type_id_fn<Class, Registry>;
+
+            if constexpr (stores_id::value) {
+                static const type_id result = assign<Class>();
+
+                return result;
+            } else {
+                return base_rtti::template static_type<Class>();
+            }
+        }
+
+        //! Returns the dense @ref type_id of the dynamic type of an object.
+        //!
+        //! Returns the result of `boost_openmethod_type_id(obj, Registry*)`,
+        //! found via ADL.
+        //!
+        //! @tparam Class A registered class.
+        //! @param obj A reference to an instance of `Class`.
+        //! @return The type_id of `obj`'s class.
+        template<class Class>
+        static auto dynamic_type(const Class& obj) -> type_id {
+            static_assert(
+                detail::has_dense_type_id_fn<Class, Registry>::value,
+                "dense_rtti requires classes to store their type id, e.g. "
+                "via dense_type_id_base");
+
+            return boost_openmethod_type_id(
+                obj, static_cast<Registry*>(nullptr));
+        }
+
+        //! Writes a representation of a @ref type_id to a stream.
+        //!
+        //! Forwards to `Rtti`.
+        //!
+        //! @tparam Stream A SimpleOutputStream.
+        //! @param type The `type_id` to write.
+        //! @param stream The stream to write to.
+        template<typename Stream>
+        static auto type_name(type_id type, Stream& stream) -> void {
+            auto& types = data().types;
+            auto index = std::size_t(type);
+
+            if (index < types.size()) {
+                if (index != 0) {
+                    base_rtti::type_name(types[index], stream);
+                    return;
+                }
+            } else if (index != unassigned) {
+                // Not a dense id.
+                base_rtti::type_name(type, stream);
+                return;
+            }
+
+            policies::rtti::defaults::type_name(type, stream);
+        }
+
+        //! Returns the type id itself.
+        //!
+        //! @param type A `type_id`.
+        //! @return `type`.
+        static auto type_index(type_id type) -> type_id {
+            return type;
+        }
+
+        //! Casts an object to a type.
+        //!
+        //! Forwards to `Rtti`.
+        //!
+        //! @tparam D A reference to a subclass of `B`.
+        //! @tparam B A registered class.
+        //! @param obj A reference to an instance of `B`.
+        template<typename D, typename B>
+        static auto dynamic_cast_ref(B&& obj) -> D {
+            return base_rtti::template dynamic_cast_ref<D>(
+                std::forward<B>(obj));
+        }
+    };
+};
+
+} // namespace policies
+
+//! Store a dense type id slot in a class.
+//!
+//! `dense_type_id_base` is a [CRTP
+//! mixin](https://en.wikipedia.org/wiki/Curiously_recurring_template_pattern)
+//! for the root of a class hierarchy, in a registry that uses @ref
+//! policies::dense_rtti. It stores a pointer to the `dense_rtti::id` variable
+//! of the object's class, which is set by @ref initialize, and declares the
+//! `boost_openmethod_type_id` function that `dense_rtti` uses to read it.
+//! Since the pointer does not change, objects can be created before
+//! `initialize`.
+//!
+//! Derived classes must inherit from @ref dense_type_id_derived. Otherwise,
+//! their objects have the type id of their nearest base that does. Objects of
+//! classes that are not registered have an id that is out of the range of the
+//! assigned ids.
+//!
+//! @tparam Class The root class.
+//! @tparam Registry The @ref registry in which `Class` and its derived classes
+//! are registered.
+template<class Class, class Registry = BOOST_OPENMETHOD_DEFAULT_REGISTRY>
+class dense_type_id_base {
+    template<class To, class Other>
+    friend void detail::set_dense_type_id(Other*);
+    friend auto boost_openmethod_dense_registry(Class*) -> Registry;
+    friend auto boost_openmethod_dense_bases(Class*) -> mp11::mp_list<>;
+
+    const type_id* boost_openmethod_dense_id;
+
+    friend auto
+    boost_openmethod_type_id(const Class& obj, Registry*) noexcept -> type_id {
+        return *obj.boost_openmethod_dense_id;
+    }
+
+  protected:
+    //! Set the type id slot to `Class`\'s.
+    dense_type_id_base() noexcept {
+        detail::set_dense_type_id<Class>(static_cast<Class*>(this));
+    }
+};
+
+//! Adjust the dense type id slot of a class.
+//!
+//! `dense_type_id_derived` is a [CRTP
+//! mixin](https://en.wikipedia.org/wiki/Curiously_recurring_template_pattern)
+//! that sets the type id slot, stored by @ref dense_type_id_base, to the id of
+//! `Class`. Its destructor sets it back to the id of the bases, so that
+//! methods can be called from destructors.
+//!
+//! @note `Base` and `MoreBases` must not be virtual bases of `Class`: they
+//! cannot be reached from the mixin before the construction of `Class` starts.
+//! In that case, store the id in a member, as described in @ref
+//! policies::dense_rtti.
+//!
+//! @tparam Class The class.
+//! @tparam Base A direct base class of `Class`.
+//! @tparam MoreBases More direct base classes of `Class`.
+template<class Class, class Base, class... MoreBases>
+class dense_type_id_derived {
+    using registry = detail::dense_type_id_registry<Base>;
+
+    template<class To, class Other>
+    friend void detail::set_dense_type_id(Other*);
+    friend auto boost_openmethod_dense_registry(Class*) -> registry;
+    friend auto boost_openmethod_dense_bases(Class*)
+        -> mp11::mp_list<Base, MoreBases...>;
+
+    friend auto boost_openmethod_type_id(const Class& obj, registry* r) noexcept
+        -> type_id {
+        return boost_openmethod_type_id(static_cast<const Base&>(obj), r);
+    }
+
+  protected:
+    //! Set the type id slot to `Class`\'s.
+    dense_type_id_derived() noexcept {
+        detail::set_dense_type_id<Class>(static_cast<Class*>(this));
+    }
+
+    //! Set the type id slot in each base class to the base's.
+    ~dense_type_id_derived() noexcept {
+        auto obj = static_cast<Class*>(this);
+        detail::set_dense_type_id<Base>(static_cast<Base*>(obj));
+        (detail::set_dense_type_id<MoreBases>(static_cast<MoreBases*>(obj)),
+         ...);
+    }
+};
+
+} // namespace boost::openmethod
+
+#endif
@@ -0,0 +1,234 @@
+// Copyright (c) 2018-2025 Jean-Louis Leroy
+// Distributed under the Boost Software License, Version 1.0.
+// See accompanying file LICENSE_1_0.txt
+// or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_OPENMETHOD_POLICY_DISPATCH_PROFILER_HPP
+#define BOOST_OPENMETHOD_POLICY_DISPATCH_PROFILER_HPP
+
+#include <boost/openmethod/preamble.hpp>
+
+#include <algorithm>
+#include <fstream>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <tuple>
+#include <unordered_map>
+#include <vector>
+
+namespace boost::openmethod::policies {
+
+//! Counts method calls, per method, virtual argument and class.
+//!
+//! `dispatch_profiler` implements the @ref profiler policy. Each time a method
+//! is called, it increments a counter for each virtual argument, keyed by the
+//! method, the position of the argument, and the v-table of the argument's
+//! dynamic class. The counters can be saved to a file, which can be passed to
+//! a later call to @ref initialize, via the @ref profile option, to lay out the
+//! dispatch data according to the measured call frequencies.
+//!
+//! Each thread has its own counters, guarded by a mutex that other threads
+//! take only to read or reset them. Method calls in different threads do not
+//! contend with each other. The counters are merged by `count`, `write` and
+//! `save`. The counters of a thread are kept after it exits. Profiling is
+//! meant for training runs, not for production builds.
+//!
+//! Since counters are keyed by v-table, they are reset by each call to
+//! `initialize`. Classes that share a v-table, because they do not override
+//! anything, are counted together, under one of the classes.
+struct dispatch_profiler : profiler {
+    //! A ProfilerFn metafunction.
+    //!
+    //! @tparam Registry The registry containing this policy.
+    template<class Registry>
+    class fn {
+        using key =
+            std::tuple<const detail::method_info*, std::size_t, vptr_type>;
+
+        struct key_hash {
+            auto operator()(const key& k) const -> std::size_t {
+                auto [method, param, vptr] = k;
+
+                return std::hash<const void*>()(method) ^
+                    (std::hash<const void*>()(vptr) * 31 + param);
+            }
+        };
+
+        using counters = std::unordered_map<key, std::size_t, key_hash>;
+
+        // The counters of a thread.
+        struct thread_counters {
+            std::mutex mutex;
+            counters counts;
+
+            thread_counters() {
+                std::lock_guard<std::mutex> lock(fn::mutex);
+                threads.push_back(this);
+            }
+
+            ~thread_counters() {
+                std::lock_guard<std::mutex> lock(fn::mutex);
+
+                for (auto& [k, n] : counts) {
+                    retired[k] += n;
+                }
+
+                threads.erase(std::find(threads.begin(), threads.end(), this));
+            }
+        };
+
+        // Guards `threads`, `retired` and `classes`.
+        static inline std::mutex mutex;
+        static inline std::vector<thread_counters*> threads;
+        // The counters of the threads that have exited.
+        static inline counters retired;
+        static inline std::unordered_map<vptr_type, type_id> classes;
+
+        static auto local() -> thread_counters& {
+            static thread_local thread_counters instance;
+
+            return instance;
+        }
+
+        // Requires `mutex`.
+        static auto merge() -> std::map<key, std::size_t> {
+            std::map<key, std::size_t> result(retired.begin(), retired.end());
+
+            for (auto thread : threads) {
+                std::lock_guard<std::mutex> lock(thread->mutex);
+
+                for (auto& [k, n] : thread->counts) {
+                    result[k] += n;
+                }
+            }
+
+            return result;
+        }
+
+        // Requires `mutex`.
+        static auto clear() -> void {
+            retired.clear();
+
+            for (auto thread : threads) {
+                std::lock_guard<std::mutex> lock(thread->mutex);
+                thread->counts.clear();
+            }
+        }
+
+      public:
+        //! Maps v-table pointers to classes, and resets the counters.
+        //!
+        //! @tparam Context An @ref InitializeContext.
+        //! @tparam Options... Zero or more option types.
+        //! @param ctx A Context object.
+        //! @param options A tuple of option objects.
+        template<class Context, class... Options>
+        static auto
+        initialize(const Context& ctx, const std::tuple<Options...>&) -> void {
+            std::lock_guard<std::mutex> lock(mutex);
+            clear();
+            classes.clear();
+
+            for (auto iter = ctx.classes_begin(); iter != ctx.classes_end();
+                 ++iter) {
+                // Classes that are not used by any method have an empty
+                // v-table, which may share its address with another v-table.
+                if (iter->slots_begin() != iter->slots_end()) {
+                    classes[iter->vptr()] = *iter->type_id_begin();
+                }
+            }
+        }
+
+        //! Increments the counter for a virtual argument.
+        //!
+        //! @param method The method being called.
+        //! @param param The index of the argument, among the virtual arguments.
+        //! @param vptr The v-table pointer of the argument.
+        static auto record(
+            const detail::method_info& method, std::size_t param,
+            vptr_type vptr) -> void {
+            auto& thread = local();
+            std::lock_guard<std::mutex> lock(thread.mutex);
+            ++thread.counts[key(&method, param, vptr)];
+        }
+
+        //! Returns the count for a virtual argument.
+        //!
+        //! @tparam Class A registered class.
+        //! @param method The method.
+        //! @param param The index of the argument, among the virtual arguments.
+        //! @return The number of calls to `method` with a `Class` object as its
+        //! `param`-th virtual argument, since the last reset.
+        template<class Class>
+        static auto count(const detail::method_info& method, std::size_t param)
+            -> std::size_t {
+            std::lock_guard<std::mutex> lock(mutex);
+            auto k =
+                key(&method, param, Registry::template static_vptr<Class>);
+            auto retired_iter = retired.find(k);
+            std::size_t result =
+                retired_iter == retired.end() ? 0 : retired_iter->second;
+
+            for (auto thread : threads) {
+                std::lock_guard<std::mutex> thread_lock(thread->mutex);
+                auto iter = thread->counts.find(k);
+
+                if (iter != thread->counts.end()) {
+                    result += iter->second;
+                }
+            }
+
+            return result;
+        }
+
+        //! Resets all the counters, in all threads.
+        static auto reset() -> void {
+            std::lock_guard<std::mutex> lock(mutex);
+            clear();
+        }
+
+        //! Writes the counters to a stream.
+        //!
+        //! Writes one line per counter, containing the count, the index of the
+        //! virtual argument, the name of the method, and the name of the class,
+        //! separated by tabs.
+        //!
+        //! @tparam Stream A @ref LightweightOutputStream.
+        //! @param os The stream to write to.
+        template<class Stream>
+        static auto write(Stream& os) -> void {
+            std::lock_guard<std::mutex> lock(mutex);
+
+            for (auto& [k, n] : merge()) {
+                auto [method, param, vptr] = k;
+                auto iter = classes.find(vptr);
+
+                if (iter == classes.end()) {
+                    continue;
+                }
+
+                os << n << "\t" << param << "\t";
+                Registry::rtti::type_name(method->method_type_id, os);
+                os << "\t";
+                Registry::rtti::type_name(iter->second, os);
+                os << "\n";
+            }
+        }
+
+        //! Writes the counters to a file.
+        //!
+        //! @param path The path of the file.
+        //! @return `true` if the file was written successfully.
+        static auto save(const std::string& path) -> bool {
+            std::ofstream os(path);
+            write(os);
+
+            return bool(os);
+        }
+    };
+};
+
+} // namespace boost::openmethod::policies
+
+#endif
@@ -31,7 +31,7 @@ constexpr uintptr uintptr_max = (std::numeric_limits<std::size_t>::max)();
 #endif
 
 template<class Registry>
-std::vector<type_id> fast_perfect_hash_control;
+runtime_vector<type_id, Registry> fast_perfect_hash_control;
 
 } // namespace detail
 
@@ -82,7 +82,8 @@ struct fast_perfect_hash : type_hash {
 
         template<class InitializeContext, class... Options>
         static void initialize(
-            const InitializeContext& ctx, std::vector<type_id>& buckets,
+            const InitializeContext& ctx,
+            detail::scratch_vector<type_id>& buckets,
             const std::tuple<Options...>& options);
 
       public:
@@ -101,12 +102,13 @@ struct fast_perfect_hash : type_hash {
         template<class Context, class... Options>
         static auto
         initialize(const Context& ctx, const std::tuple<Options...>& options) {
+            detail::scratch_vector<type_id> buckets;
+            initialize(ctx, buckets, options);
+
             if constexpr (Registry::has_runtime_checks) {
-                initialize(
-                    ctx, detail::fast_perfect_hash_control<Registry>, options);
-            } else {
-                std::vector<type_id> buckets;
-                initialize(ctx, buckets, options);
+                detail::runtime_vector<type_id, Registry> control(
+                    buckets.begin(), buckets.end());
+                detail::fast_perfect_hash_control<Registry>.swap(control);
             }
 
             return std::pair{min_value, max_value};
@@ -164,7 +166,7 @@ std::size_t fast_perfect_hash::fn<Registry>::max_value;
 template<class Registry>
 template<class InitializeContext, class... Options>
 void fast_perfect_hash::fn<Registry>::initialize(
-    const InitializeContext& ctx, std::vector<type_id>& buckets,
+    const InitializeContext& ctx, detail::scratch_vector<type_id>& buckets,
     const std::tuple<Options...>& options) {
     (void)options;
 
@@ -0,0 +1,171 @@
+// Copyright (c) 2018-2025 Jean-Louis Leroy
+// Distributed under the Boost Software License, Version 1.0.
+// See accompanying file LICENSE_1_0.txt
+// or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_OPENMETHOD_POLICY_HEADER_VPTR_HPP
+#define BOOST_OPENMETHOD_POLICY_HEADER_VPTR_HPP
+
+#include <boost/openmethod/preamble.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <variant>
+
+namespace boost::openmethod {
+
+namespace detail {
+
+// Stored immediately before an object allocated by header_vptr_allocator. The
+// v-table pointer is the last word, i.e. it is at
+// `reinterpret_cast<const vptr_type* const*>(obj) - 1`.
+struct vptr_header {
+    // Size of the block, in units of `vptr_header_unit`.
+    std::size_t size;
+    // Address of the object, scrambled; checks that the header is genuine.
+    std::uintptr_t tag;
+    // Address of the `static_vptr` of the object's class.
+    const vptr_type* vptr;
+};
+
+struct alignas(__STDCPP_DEFAULT_NEW_ALIGNMENT__) vptr_header_unit {
+    unsigned char bytes[__STDCPP_DEFAULT_NEW_ALIGNMENT__];
+};
+
+// Distance between the start of the block and the object.
+constexpr std::size_t vptr_header_size =
+    (sizeof(vptr_header) + sizeof(vptr_header_unit) - 1) /
+    sizeof(vptr_header_unit) * sizeof(vptr_header_unit);
+
+inline auto vptr_header_tag(const void* obj) -> std::uintptr_t {
+    return reinterpret_cast<std::uintptr_t>(obj) ^
+        std::uintptr_t(0x9e3779b97f4a7c15ull);
+}
+
+// Return the address of the complete object.
+template<class Class>
+auto vptr_header_object(const Class& obj) -> const void* {
+    if constexpr (std::is_polymorphic_v<Class>) {
+        return dynamic_cast<const void*>(&obj);
+    } else {
+        return &obj;
+    }
+}
+
+template<class Class>
+auto vptr_header_of(const Class& obj) -> const vptr_header& {
+    return *(static_cast<const vptr_header*>(vptr_header_object(obj)) - 1);
+}
+
+} // namespace detail
+
+namespace policies {
+
+//! Reads v-table pointers from a header placed before the objects.
+//!
+//! `header_vptr` works with objects allocated by @ref header_vptr_allocator,
+//! or one of the functions based on it, e.g. @ref make_header_vptr_unique.
+//! These functions allocate a hidden header in front of each object, and
+//! store the address of the @ref registry::static_vptr of the object's class
+//! in its last word. `dynamic_vptr` finds the complete object - using
+//! `dynamic_cast<const void*>` if the class is polymorphic - and reads the
+//! word that precedes it. It does not use the @ref rtti policy, and does not
+//! look up a table. This makes it possible to use `virtual_ptr`s, and
+//! virtual parameters passed by reference, with fast dispatch, for classes
+//! that cannot derive from @ref inplace_vptr_base.
+//!
+//! Since the header holds a pointer to the static v-table pointer, it is not
+//! affected by a new call to @ref initialize.
+//!
+//! If the registry contains the @ref runtime_checks policy, `dynamic_vptr`
+//! checks the header's tag, which encodes the address of the object. If it
+//! does not match, or if the class of the object was not registered, and if
+//! the registry contains an @ref error_handler policy, its @ref error
+//! function is called with a @ref bad_header or a @ref missing_class value,
+//! then the program is terminated with @ref abort.
+//!
+//! @note All the objects passed as virtual arguments, in methods of the
+//! registry, must have been allocated with a header.
+struct header_vptr : vptr {
+    //! An object was not allocated with a v-table pointer header.
+    struct bad_header : openmethod_error {
+        //! The type_id of the object's class.
+        type_id type;
+
+        //! Write a short description to an output stream
+        //! @param os The output stream
+        //! @tparam Registry The registry
+        //! @tparam Stream A @ref LightweightOutputStream
+        template<class Registry, class Stream>
+        auto write(Stream& os) const -> void {
+            os << "object of class ";
+            Registry::rtti::type_name(type, os);
+            os << " has no v-table pointer header";
+        }
+    };
+
+    using errors = std::variant<bad_header>;
+
+    //! A VptrFn metafunction.
+    //!
+    //! @tparam Registry The registry containing this policy.
+    template<class Registry>
+    struct fn {
+        //! Does nothing.
+        //!
+        //! The headers point to the static v-table pointers, which are set
+        //! by @ref initialize.
+        //!
+        //! @tparam Context An @ref InitializeContext.
+        //! @tparam Options... Zero or more option types.
+        //! @param ctx A Context object.
+        //! @param options A tuple of option objects.
+        template<class Context, class... Options>
+        static auto
+        initialize(const Context&, const std::tuple<Options...>&) -> void {
+        }
+
+        //! Returns a reference to the v-table pointer for an object.
+        //!
+        //! Reads the address of the v-table pointer from the header that
+        //! precedes the complete object.
+        //!
+        //! @tparam Class A registered class.
+        //! @param arg A reference to a const object of type `Class`.
+        //! @return A reference to a the v-table pointer for `Class`.
+        template<class Class>
+        static auto dynamic_vptr(const Class& arg) -> const vptr_type& {
+            auto& header = detail::vptr_header_of(arg);
+
+            if constexpr (Registry::has_runtime_checks) {
+                if (header.tag !=
+                    detail::vptr_header_tag(detail::vptr_header_object(arg))) {
+                    if constexpr (Registry::has_error_handler) {
+                        bad_header error;
+                        error.type = Registry::rtti::dynamic_type(arg);
+                        Registry::error_handler::error(error);
+                    }
+
+                    abort();
+                }
+
+                if (!*header.vptr) {
+                    if constexpr (Registry::has_error_handler) {
+                        missing_class error;
+                        error.type = Registry::rtti::dynamic_type(arg);
+                        Registry::error_handler::error(error);
+                    }
+
+                    abort();
+                }
+            }
+
+            return *header.vptr;
+        }
+    };
+};
+
+} // namespace policies
+} // namespace boost::openmethod
+
+#endif
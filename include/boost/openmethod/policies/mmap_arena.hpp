@@ -0,0 +1,229 @@
+// Copyright (c) 2018-2025 Jean-Louis Leroy
+// Distributed under the Boost Software License, Version 1.0.
+// See accompanying file LICENSE_1_0.txt
+// or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_OPENMETHOD_POLICY_MMAP_ARENA_HPP
+#define BOOST_OPENMETHOD_POLICY_MMAP_ARENA_HPP
+
+#include <boost/openmethod/preamble.hpp>
+
+#include <new>
+#include <vector>
+
+#if !defined(_WIN32) && __has_include(<sys/mman.h>)
+#include <sys/mman.h>
+#define BOOST_OPENMETHOD_DETAIL_HAS_MMAP
+#endif
+
+namespace boost::openmethod::policies {
+
+//! Allocates the runtime data in page-aligned, read-only memory.
+//!
+//! `mmap_arena` implements the @ref arena policy. It allocates the dispatch
+//! data, and the tables of the stock @ref vptr and @ref type_hash policies,
+//! contiguously, from regions of `RegionSize` bytes obtained with `mmap`. Each
+//! block is aligned on a cache line. If `HugePages` is `true`, and the
+//! platform supports it, the regions are aligned on their size, and
+//! `madvise(MADV_HUGEPAGE)` is requested for them; if the request fails, normal
+//! pages are used. With the default region size, the runtime data of most
+//! programs fits in a single huge page.
+//!
+//! After @ref initialize has written the runtime data, the regions are made
+//! read-only. They are made writable again, and reused, by the next call to
+//! `initialize`.
+//!
+//! On platforms without `mmap`, the regions are allocated with `operator new`,
+//! and are not write-protected.
+//!
+//! @note The static v-table pointers (@ref registry::static_vptr) and the
+//! method slot tables are variables in the program's data segment; they are
+//! not placed in the arena.
+//!
+//! @tparam HugePages Whether to request transparent huge pages.
+//! @tparam RegionSize The minimum size of a region.
+template<bool HugePages = true, std::size_t RegionSize = std::size_t(2) << 20>
+struct mmap_arena : arena {
+    //! An ArenaFn metafunction.
+    //!
+    //! @tparam Registry The registry containing this policy.
+    template<class Registry>
+    class fn {
+        struct region {
+            char* base;
+            std::size_t size;
+        };
+
+        static inline std::vector<region> regions;
+        static inline std::size_t current = 0;
+        static inline char* next = nullptr;
+        static inline char* last = nullptr;
+
+        static auto map(std::size_t size) -> region {
+            size = (size + RegionSize - 1) / RegionSize * RegionSize;
+
+#ifdef BOOST_OPENMETHOD_DETAIL_HAS_MMAP
+            // Over-allocate, then trim, to align the region on its size.
+            auto mapped = HugePages ? 2 * size : size;
+            void* p = mmap(
+                nullptr, mapped, PROT_READ | PROT_WRITE,
+                MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+
+            if (p == MAP_FAILED) {
+                throw std::bad_alloc();
+            }
+
+            auto base = static_cast<char*>(p);
+
+            if constexpr (HugePages) {
+                auto aligned = reinterpret_cast<char*>(
+                    (reinterpret_cast<std::uintptr_t>(base) + size - 1) /
+                    size * size);
+
+                if (aligned != base) {
+                    munmap(base, aligned - base);
+                }
+
+                if (aligned + size != base + mapped) {
+                    munmap(aligned + size, base + mapped - (aligned + size));
+                }
+
+                base = aligned;
+
+#ifdef MADV_HUGEPAGE
+                // Not an error if unsupported, we just get normal pages.
+                madvise(base, size, MADV_HUGEPAGE);
+#endif
+            }
+
+            return {base, size};
+#else
+            return {
+                static_cast<char*>(::operator new(
+                    size, std::align_val_t(detail::cache_line_size))),
+                size};
+#endif
+        }
+
+        static void unmap(const region& r) {
+#ifdef BOOST_OPENMETHOD_DETAIL_HAS_MMAP
+            munmap(r.base, r.size);
+#else
+            ::operator delete(
+                r.base, std::align_val_t(detail::cache_line_size));
+#endif
+        }
+
+        static void protect(const region& r, bool writable) {
+#ifdef BOOST_OPENMETHOD_DETAIL_HAS_MMAP
+            mprotect(
+                r.base, r.size, writable ? PROT_READ | PROT_WRITE : PROT_READ);
+#else
+            (void)r;
+            (void)writable;
+#endif
+        }
+
+      public:
+        //! Makes the regions writable, and restarts allocation from the first
+        //! one.
+        static auto begin_update() -> void {
+            for (auto& r : regions) {
+                protect(r, true);
+            }
+
+            current = 0;
+
+            if (regions.empty()) {
+                next = last = nullptr;
+            } else {
+                next = regions.front().base;
+                last = next + regions.front().size;
+            }
+        }
+
+        //! Allocates a block from the current region.
+        //!
+        //! If the current region is exhausted, moves to the next region,
+        //! mapping a new one if necessary.
+        //!
+        //! @param size The size of the block, in bytes.
+        //! @param alignment The alignment of the block.
+        //! @return A pointer to the block.
+        static auto allocate(std::size_t size, std::size_t alignment) -> void* {
+            for (;;) {
+                if (next) {
+                    auto aligned = reinterpret_cast<char*>(
+                        (reinterpret_cast<std::uintptr_t>(next) + alignment -
+                         1) &
+                        ~(std::uintptr_t(alignment) - 1));
+
+                    if (aligned + size <= last) {
+                        next = aligned + size;
+
+                        return aligned;
+                    }
+
+                    ++current;
+                }
+
+                if (current == regions.size()) {
+                    regions.push_back(map(size + alignment));
+                }
+
+                next = regions[current].base;
+                last = next + regions[current].size;
+            }
+        }
+
+        //! Releases the regions that were not used, and makes the others
+        //! read-only.
+        static auto end_update() -> void {
+            auto used = next ? current + 1 : 0;
+
+            while (regions.size() > used) {
+                unmap(regions.back());
+                regions.pop_back();
+            }
+
+            for (auto& r : regions) {
+                protect(r, false);
+            }
+        }
+
+        //! Tests if an address lies in the arena.
+        //!
+        //! @param p An address.
+        //! @return `true` if `p` points into one of the regions.
+        static auto contains(const void* p) -> bool {
+            auto cp = static_cast<const char*>(p);
+
+            for (auto& r : regions) {
+                if (cp >= r.base && cp < r.base + r.size) {
+                    return true;
+                }
+            }
+
+            return false;
+        }
+
+        //! Releases all the regions.
+        //!
+        //! @tparam Options... Zero or more option types.
+        //! @param options A tuple of option objects.
+        template<class... Options>
+        static auto finalize(const std::tuple<Options...>&) -> void {
+            for (auto& r : regions) {
+                unmap(r);
+            }
+
+            regions.clear();
+            current = 0;
+            next = last = nullptr;
+        }
+    };
+};
+
+} // namespace boost::openmethod::policies
+
+#endif
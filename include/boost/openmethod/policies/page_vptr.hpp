@@ -0,0 +1,156 @@
+// Copyright (c) 2018-2025 Jean-Louis Leroy
+// Distributed under the Boost Software License, Version 1.0.
+// See accompanying file LICENSE_1_0.txt
+// or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_OPENMETHOD_POLICY_PAGE_VPTR_HPP
+#define BOOST_OPENMETHOD_POLICY_PAGE_VPTR_HPP
+
+#include <boost/openmethod/preamble.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <variant>
+
+namespace boost::openmethod {
+
+namespace detail {
+
+// Start of the pages allocated by page_arena. All the objects in a page have
+// the same class.
+struct page_header {
+    // Address of the page, scrambled; checks that the header is genuine.
+    std::uintptr_t tag;
+    // Address of the `static_vptr` of the class of the objects in the page.
+    const vptr_type* vptr;
+};
+
+inline auto page_tag(const void* page) -> std::uintptr_t {
+    return reinterpret_cast<std::uintptr_t>(page) ^
+        std::uintptr_t(0x94d049bb133111ebull);
+}
+
+template<std::size_t PageSize>
+auto page_of(const void* obj) -> const page_header* {
+    return reinterpret_cast<const page_header*>(
+        reinterpret_cast<std::uintptr_t>(obj) & ~(PageSize - 1));
+}
+
+} // namespace detail
+
+namespace policies {
+
+//! Finds v-table pointers from the address of the objects.
+//!
+//! `page_vptr` works with objects allocated by a @ref page_arena with the same
+//! `PageSize`. The arena groups objects by class, in pages aligned on their
+//! size, and stores the address of the @ref registry::static_vptr of the
+//! class at the start of each page. `dynamic_vptr` clears the low bits of the
+//! address of the object - or of any of its sub-objects - and reads the page
+//! header. It does not use the @ref rtti policy, does not look up a table,
+//! and does not need storage in the objects.
+//!
+//! Since the page header holds a pointer to the static v-table pointer, it is
+//! not affected by a new call to @ref initialize.
+//!
+//! If the registry contains the @ref runtime_checks policy, `dynamic_vptr`
+//! checks the page's tag, which encodes the address of the page. If it does
+//! not match, and if the registry contains an @ref error_handler policy, its
+//! @ref error function is called with a @ref bad_page value, then the program
+//! is terminated with @ref abort. The check is a best effort: reading the
+//! header of an object that was not allocated from an arena is undefined
+//! behavior.
+//!
+//! @note All the objects passed as virtual arguments, in methods of the
+//! registry, must have been allocated from a `page_arena`.
+//!
+//! @tparam PageSize The size of the pages, a power of two.
+template<std::size_t PageSize = std::size_t(64) << 10>
+struct page_vptr : vptr {
+    static_assert(
+        (PageSize & (PageSize - 1)) == 0, "PageSize must be a power of two");
+
+    //! The size of the pages.
+    static constexpr std::size_t page_size = PageSize;
+
+    //! An object was not allocated from a `page_arena`.
+    struct bad_page : openmethod_error {
+        //! The type_id of the object's class.
+        type_id type;
+
+        //! Write a short description to an output stream
+        //! @param os The output stream
+        //! @tparam Registry The registry
+        //! @tparam Stream A @ref LightweightOutputStream
+        template<class Registry, class Stream>
+        auto write(Stream& os) const -> void {
+            os << "object of class ";
+            Registry::rtti::type_name(type, os);
+            os << " was not allocated from a page arena";
+        }
+    };
+
+    using errors = std::variant<bad_page>;
+
+    //! A VptrFn metafunction.
+    //!
+    //! @tparam Registry The registry containing this policy.
+    template<class Registry>
+    struct fn {
+        //! Does nothing.
+        //!
+        //! The page headers point to the static v-table pointers, which are
+        //! set by @ref initialize.
+        //!
+        //! @tparam Context An @ref InitializeContext.
+        //! @tparam Options... Zero or more option types.
+        //! @param ctx A Context object.
+        //! @param options A tuple of option objects.
+        template<class Context, class... Options>
+        static auto
+        initialize(const Context&, const std::tuple<Options...>&) -> void {
+        }
+
+        //! Returns a reference to the v-table pointer for an object.
+        //!
+        //! Reads the address of the v-table pointer from the header of the
+        //! page that contains the object.
+        //!
+        //! @tparam Class A registered class.
+        //! @param arg A reference to a const object of type `Class`.
+        //! @return A reference to a the v-table pointer for `Class`.
+        template<class Class>
+        static auto dynamic_vptr(const Class& arg) -> const vptr_type& {
+            auto page = detail::page_of<PageSize>(&arg);
+
+            if constexpr (Registry::has_runtime_checks) {
+                if (page->tag != detail::page_tag(page)) {
+                    if constexpr (Registry::has_error_handler) {
+                        bad_page error;
+                        error.type = Registry::rtti::dynamic_type(arg);
+                        Registry::error_handler::error(error);
+                    }
+
+                    abort();
+                }
+
+                if (!*page->vptr) {
+                    if constexpr (Registry::has_error_handler) {
+                        missing_class error;
+                        error.type = Registry::rtti::dynamic_type(arg);
+                        Registry::error_handler::error(error);
+                    }
+
+                    abort();
+                }
+            }
+
+            return *page->vptr;
+        }
+    };
+};
+
+} // namespace policies
+} // namespace boost::openmethod
+
+#endif
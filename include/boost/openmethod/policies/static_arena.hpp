@@ -0,0 +1,216 @@
+// Copyright (c) 2018-2025 Jean-Louis Leroy
+// Distributed under the Boost Software License, Version 1.0.
+// See accompanying file LICENSE_1_0.txt
+// or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_OPENMETHOD_POLICY_STATIC_ARENA_HPP
+#define BOOST_OPENMETHOD_POLICY_STATIC_ARENA_HPP
+
+#include <boost/openmethod/preamble.hpp>
+
+#include <variant>
+
+namespace boost::openmethod::policies {
+
+//! Allocates the runtime data from fixed-size, static buffers.
+//!
+//! `static_arena` implements the @ref arena policy. It allocates the dispatch
+//! data, and the tables of the stock @ref vptr and @ref type_hash policies,
+//! from a buffer of `Capacity` bytes, with static storage duration. Once @ref
+//! initialize has returned, method dispatch does not touch the heap, and the
+//! runtime data never moves.
+//!
+//! The temporary data structures of @ref initialize - classes, methods,
+//! slots, dispatch table cells, etc - are allocated from a second buffer, of
+//! `ScratchCapacity` bytes. It is used as a stack: a block is reclaimed when
+//! it is the last one allocated, and the whole buffer, when all the blocks have
+//! been released. Thus `initialize` does not touch the heap either, unless it
+//! loads a profile.
+//!
+//! If the runtime data does not fit in its buffer, @ref initialize reports a
+//! @ref capacity_error via the registry's @ref error_handler, if any, then
+//! calls `abort`. Likewise, if the temporary data does not fit, it reports a
+//! @ref scratch_capacity_error. `used` and `scratch_used` return the number of
+//! bytes used by the last call to `initialize`, and can serve as a guide to
+//! tune the capacities.
+//!
+//! @note The object returned by `initialize` with the @ref retain_compiler
+//! option holds its scratch blocks until it is destroyed. Until then, the
+//! scratch buffer is not reset, and the temporary data of later calls to
+//! `initialize` is allocated after them, which must be accounted for in
+//! `ScratchCapacity`.
+//!
+//! @tparam Capacity The size of the buffer for the runtime data, in bytes.
+//! @tparam ScratchCapacity The size of the buffer for the temporary data, in
+//! bytes.
+template<std::size_t Capacity, std::size_t ScratchCapacity = 4 * Capacity>
+struct static_arena : arena {
+    //! Report that the runtime data does not fit in the arena.
+    struct capacity_error : openmethod_error {
+        //! The size of the arena, in bytes.
+        std::size_t capacity;
+        //! The number of bytes needed to satisfy the failed request.
+        std::size_t requested;
+
+        //! Write a short description to an output stream
+        //! @param os The output stream
+        //! @tparam Registry The registry
+        //! @tparam Stream A @ref LightweightOutputStream
+        template<class Registry, class Stream>
+        auto write(Stream& os) const -> void {
+            os << "static arena capacity exceeded: " << requested
+               << " bytes needed, capacity is " << capacity;
+        }
+    };
+
+    //! Report that the temporary data of `initialize` does not fit in the
+    //! arena.
+    struct scratch_capacity_error : openmethod_error {
+        //! The size of the scratch buffer, in bytes.
+        std::size_t capacity;
+        //! The number of bytes needed to satisfy the failed request.
+        std::size_t requested;
+
+        //! Write a short description to an output stream
+        //! @param os The output stream
+        //! @tparam Registry The registry
+        //! @tparam Stream A @ref LightweightOutputStream
+        template<class Registry, class Stream>
+        auto write(Stream& os) const -> void {
+            os << "static arena scratch capacity exceeded: " << requested
+               << " bytes needed, capacity is " << capacity;
+        }
+    };
+
+    using errors = std::variant<capacity_error, scratch_capacity_error>;
+
+    //! An ArenaFn metafunction.
+    //!
+    //! @tparam Registry The registry containing this policy.
+    template<class Registry>
+    class fn {
+        alignas(detail::cache_line_size) static inline char storage[Capacity];
+        static inline std::size_t next = 0;
+
+        alignas(detail::cache_line_size) static inline char
+            scratch[ScratchCapacity];
+        static inline std::size_t scratch_next = 0;
+        static inline std::size_t scratch_blocks = 0;
+        static inline std::size_t scratch_peak = 0;
+
+      public:
+        //! The size of the buffer, in bytes.
+        static constexpr std::size_t capacity = Capacity;
+
+        //! The size of the scratch buffer, in bytes.
+        static constexpr std::size_t scratch_capacity = ScratchCapacity;
+
+        //! Restarts allocation from the beginning of the buffer.
+        static auto begin_update() -> void {
+            next = 0;
+        }
+
+        //! Allocates a block from the buffer.
+        //!
+        //! @param size The size of the block, in bytes.
+        //! @param alignment The alignment of the block.
+        //! @return A pointer to the block.
+        static auto allocate(std::size_t size, std::size_t alignment) -> void* {
+            auto offset = (next + alignment - 1) & ~(alignment - 1);
+
+            if (offset > Capacity || size > Capacity - offset) {
+                capacity_error error;
+                error.capacity = Capacity;
+                error.requested = offset + size;
+
+                if constexpr (Registry::has_error_handler) {
+                    Registry::error_handler::error(error);
+                }
+
+                abort();
+            }
+
+            next = offset + size;
+
+            return storage + offset;
+        }
+
+        //! Does nothing.
+        static auto end_update() -> void {
+        }
+
+        //! Returns the number of bytes allocated since the last call to
+        //! `begin_update`.
+        static auto used() -> std::size_t {
+            return next;
+        }
+
+        //! Allocates a block from the scratch buffer.
+        //!
+        //! @param size The size of the block, in bytes.
+        //! @param alignment The alignment of the block.
+        //! @return A pointer to the block.
+        static auto scratch_allocate(std::size_t size, std::size_t alignment)
+            -> void* {
+            if (scratch_blocks == 0) {
+                // A new call to `initialize`.
+                scratch_peak = 0;
+            }
+
+            auto offset = (scratch_next + alignment - 1) & ~(alignment - 1);
+
+            if (offset > ScratchCapacity || size > ScratchCapacity - offset) {
+                scratch_capacity_error error;
+                error.capacity = ScratchCapacity;
+                error.requested = offset + size;
+
+                if constexpr (Registry::has_error_handler) {
+                    Registry::error_handler::error(error);
+                }
+
+                abort();
+            }
+
+            scratch_next = offset + size;
+            ++scratch_blocks;
+
+            if (scratch_next > scratch_peak) {
+                scratch_peak = scratch_next;
+            }
+
+            return scratch + offset;
+        }
+
+        //! Releases a block allocated by `scratch_allocate`.
+        //!
+        //! @param p A pointer to the block.
+        //! @param size The size of the block, in bytes.
+        static auto scratch_deallocate(void* p, std::size_t size) -> void {
+            if (--scratch_blocks == 0) {
+                scratch_next = 0;
+            } else if (static_cast<char*>(p) + size == scratch + scratch_next) {
+                scratch_next -= size;
+            }
+        }
+
+        //! Returns the largest number of bytes in use in the scratch buffer,
+        //! during the last call to `initialize`.
+        static auto scratch_used() -> std::size_t {
+            return scratch_peak;
+        }
+
+        //! Tests if an address lies in the arena.
+        //!
+        //! @param p An address.
+        //! @return `true` if `p` points into the buffer.
+        static auto contains(const void* p) -> bool {
+            auto cp = static_cast<const char*>(p);
+
+            return cp >= storage && cp < storage + Capacity;
+        }
+    };
+};
+
+} // namespace boost::openmethod::policies
+
+#endif
@@ -0,0 +1,294 @@
+// Copyright (c) 2018-2025 Jean-Louis Leroy
+// Distributed under the Boost Software License, Version 1.0.
+// See accompanying file LICENSE_1_0.txt
+// or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_OPENMETHOD_POLICY_VPTR_FLAT_MAP_HPP
+#define BOOST_OPENMETHOD_POLICY_VPTR_FLAT_MAP_HPP
+
+#include <boost/openmethod/preamble.hpp>
+
+#include <cstdint>
+#include <vector>
+
+#if defined(__SSE2__) || defined(_M_X64) ||                                    \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define BOOST_OPENMETHOD_DETAIL_FLAT_MAP_SSE2
+#include <emmintrin.h>
+#endif
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+
+namespace boost::openmethod {
+
+namespace detail {
+
+// Swiss-table style open addressing. The table is divided in groups of 16
+// slots. Each slot has a control byte: `flat_map_empty`, or the low 7 bits of
+// the hash of the key stored in the slot. A lookup scans the control bytes of
+// a group in parallel (using SSE2 if available), then compares the keys of the
+// matching slots only.
+
+constexpr std::size_t flat_map_group_width = 16;
+constexpr std::uint8_t flat_map_empty = 0x80;
+
+inline auto flat_map_countr_zero(std::uint32_t mask) -> unsigned {
+#if defined(_MSC_VER) && !defined(__clang__)
+    unsigned long index;
+    _BitScanForward(&index, mask);
+    return index;
+#elif defined(__GNUC__) || defined(__clang__)
+    return __builtin_ctz(mask);
+#else
+    unsigned index = 0;
+
+    while (!(mask & 1)) {
+        mask >>= 1;
+        ++index;
+    }
+
+    return index;
+#endif
+}
+
+// Returns a mask with one bit set for each control byte equal to `value`.
+inline auto flat_map_match(const std::uint8_t* group, std::uint8_t value)
+    -> std::uint32_t {
+#ifdef BOOST_OPENMETHOD_DETAIL_FLAT_MAP_SSE2
+    auto ctrl = _mm_loadu_si128(reinterpret_cast<const __m128i*>(group));
+
+    return static_cast<std::uint32_t>(_mm_movemask_epi8(
+        _mm_cmpeq_epi8(_mm_set1_epi8(static_cast<char>(value)), ctrl)));
+#else
+    std::uint32_t mask = 0;
+
+    for (std::size_t i = 0; i < flat_map_group_width; ++i) {
+        mask |= std::uint32_t(group[i] == value) << i;
+    }
+
+    return mask;
+#endif
+}
+
+inline auto flat_map_hash(type_id type) -> std::size_t {
+    auto h = std::size_t(type);
+
+    if constexpr (sizeof(std::size_t) == 8) {
+        h *= std::size_t(0x9E3779B97F4A7C15ull);
+        h ^= h >> 32;
+    } else {
+        h *= std::size_t(0x9E3779B9u);
+        h ^= h >> 16;
+    }
+
+    return h;
+}
+
+} // namespace detail
+
+namespace policies {
+
+//! Stores v-table pointers in an open-addressing hash table.
+//!
+//! `vptr_flat_map` stores `type_id`s and v-table pointers side by side, in a
+//! flat array, and locates them using "Swiss table" style probing: the slots
+//! are divided in groups of 16, each slot having a one-byte tag derived from
+//! the hash of its key. The tags of a group are compared with the tag of the
+//! searched key in a single SSE2 instruction, when available. Unlike @ref
+//! vptr_map with its default `std::unordered_map`, a lookup does not chase
+//! pointers to heap-allocated nodes.
+//!
+//! `vptr_flat_map` is suitable for large, sparse sets of types, for which
+//! @ref fast_perfect_hash would produce large tables or take long to
+//! initialize. It does not use the registry's @ref type_hash policy.
+//!
+//! If the registry contains the @ref indirect_vptr policy, `vptr_flat_map`
+//! stores pointers to pointers to v-tables.
+struct vptr_flat_map : vptr {
+    //! A VptrFn metafunction.
+    //!
+    //! @tparam Registry The registry containing this policy.
+    template<class Registry>
+    class fn {
+        using Value = std::conditional_t<
+            Registry::has_indirect_vptr, const vptr_type*, vptr_type>;
+
+        struct entry {
+            type_id type;
+            Value vptr;
+        };
+
+        static inline detail::runtime_vector<std::uint8_t, Registry> control;
+        static inline detail::runtime_vector<entry, Registry> entries;
+        static inline std::size_t group_mask;
+        static inline vptr_type null_vptr = nullptr;
+
+        static auto find(type_id type) -> const entry* {
+            using namespace detail;
+
+            // Before `initialize`, or after `finalize`.
+            if (control.empty()) {
+                return nullptr;
+            }
+
+            auto h = flat_map_hash(type);
+            auto tag = static_cast<std::uint8_t>(h & 0x7f);
+            auto group = (h >> 7) & group_mask;
+
+            for (std::size_t step = 1;; ++step) {
+                auto first = group * flat_map_group_width;
+                auto ctrl = control.data() + first;
+
+                for (auto mask = flat_map_match(ctrl, tag); mask;
+                     mask &= mask - 1) {
+                    auto& candidate =
+                        entries[first + flat_map_countr_zero(mask)];
+
+                    if (candidate.type == type) {
+                        return &candidate;
+                    }
+                }
+
+                if (flat_map_match(ctrl, flat_map_empty)) {
+                    return nullptr;
+                }
+
+                // Triangular probing visits every group, because the number
+                // of groups is a power of two.
+                group = (group + step) & group_mask;
+            }
+        }
+
+      public:
+        //! Stores the v-table pointers.
+        //!
+        //! Sizes the table so that it is at most 7/8 full, then inserts the
+        //! `type_id`s and v-table pointers of all the registered classes.
+        //!
+        //! @tparam Context An @ref InitializeContext.
+        //! @tparam Options... Zero or more option types.
+        //! @param ctx A Context object.
+        //! @param options A tuple of option objects.
+        template<class Context, class... Options>
+        static void
+        initialize(const Context& ctx, const std::tuple<Options...>&) {
+            using namespace detail;
+
+            std::size_t size = 0;
+
+            for (auto iter = ctx.classes_begin(); iter != ctx.classes_end();
+                 ++iter) {
+                size +=
+                    std::distance(iter->type_id_begin(), iter->type_id_end());
+            }
+
+            std::size_t groups = 1;
+
+            while (groups * flat_map_group_width * 7 < size * 8) {
+                groups *= 2;
+            }
+
+            // At most 7/8 full, so there is always an empty slot to end a
+            // probe sequence.
+            detail::runtime_vector<std::uint8_t, Registry> new_control(
+                groups * flat_map_group_width, flat_map_empty);
+            detail::runtime_vector<entry, Registry> new_entries(
+                groups * flat_map_group_width);
+            auto mask = groups - 1;
+
+            for (auto iter = ctx.classes_begin(); iter != ctx.classes_end();
+                 ++iter) {
+                for (auto type_iter = iter->type_id_begin();
+                     type_iter != iter->type_id_end(); ++type_iter) {
+                    auto h = flat_map_hash(*type_iter);
+                    auto group = (h >> 7) & mask;
+
+                    for (std::size_t step = 1;; ++step) {
+                        auto first = group * flat_map_group_width;
+                        auto empty = flat_map_match(
+                            new_control.data() + first, flat_map_empty);
+
+                        if (empty) {
+                            auto index = first + flat_map_countr_zero(empty);
+                            new_control[index] =
+                                static_cast<std::uint8_t>(h & 0x7f);
+                            new_entries[index].type = *type_iter;
+
+                            if constexpr (Registry::has_indirect_vptr) {
+                                new_entries[index].vptr = &iter->vptr();
+                            } else {
+                                new_entries[index].vptr = iter->vptr();
+                            }
+
+                            break;
+                        }
+
+                        group = (group + step) & mask;
+                    }
+                }
+            }
+
+            control.swap(new_control);
+            entries.swap(new_entries);
+            group_mask = mask;
+        }
+
+        //! Returns a reference to a v-table pointer for an object.
+        //!
+        //! Acquires the dynamic @ref type_id of `arg`, using the registry's
+        //! @ref rtti policy.
+        //!
+        //! If the registry contains the @ref runtime_checks policy, checks that
+        //! the table contains the type id. If it does not, and if the registry
+        //! contains a @ref error_handler policy, calls its
+        //! @ref error function with a @ref missing_class value, then
+        //! terminates the program with @ref abort.
+        //!
+        //! @tparam Class A registered class.
+        //! @param arg A reference to a const object of type `Class`.
+        //! @return A reference to a the v-table pointer for `Class`.
+        template<class Class>
+        static auto dynamic_vptr(const Class& arg) -> const vptr_type& {
+            auto type = Registry::rtti::dynamic_type(arg);
+            auto found = find(type);
+
+            if (!found) {
+                if constexpr (Registry::has_runtime_checks) {
+                    if constexpr (Registry::has_error_handler) {
+                        missing_class error;
+                        error.type = type;
+                        Registry::error_handler::error(error);
+                    }
+
+                    abort();
+                }
+
+                return null_vptr;
+            }
+
+            if constexpr (Registry::has_indirect_vptr) {
+                return *found->vptr;
+            } else {
+                return found->vptr;
+            }
+        }
+
+        //! Releases the memory allocated by `initialize`.
+        //!
+        //! @tparam Options... Zero or more option types.
+        //! @param options A tuple of option objects.
+        template<class... Options>
+        static auto finalize(const std::tuple<Options...>&) -> void {
+            control.clear();
+            entries.clear();
+            group_mask = 0;
+        }
+    };
+};
+
+} // namespace policies
+} // namespace boost::openmethod
+
+#endif
@@ -0,0 +1,231 @@
+// Copyright (c) 2018-2025 Jean-Louis Leroy
+// Distributed under the Boost Software License, Version 1.0.
+// See accompanying file LICENSE_1_0.txt
+// or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_OPENMETHOD_POLICY_VPTR_PREFIX_VECTOR_HPP
+#define BOOST_OPENMETHOD_POLICY_VPTR_PREFIX_VECTOR_HPP
+
+#include <boost/openmethod/preamble.hpp>
+
+#include <vector>
+
+namespace boost::openmethod {
+
+namespace detail {
+
+template<std::size_t Size>
+constexpr std::size_t vptr_prefix_bucket_alignment =
+    Size <= alignof(word)   ? alignof(word)
+    : Size <= 2 * sizeof(word) ? 2 * sizeof(word)
+    : Size <= 4 * sizeof(word) ? 4 * sizeof(word)
+                               : 8 * sizeof(word);
+
+template<class Vptr, std::size_t PrefixSlots>
+struct alignas(vptr_prefix_bucket_alignment<
+               sizeof(Vptr) + PrefixSlots * sizeof(word)>) vptr_prefix_bucket {
+    Vptr vptr;
+    word prefix[PrefixSlots];
+};
+
+template<class Registry, class Bucket>
+inline runtime_vector<Bucket, Registry> vptr_prefix_vector_buckets;
+
+} // namespace detail
+
+namespace policies {
+
+//! Stores v-table pointers in a vector, along with a copy of the first
+//! entries of the v-tables.
+//!
+//! `vptr_prefix_vector` works like @ref vptr_vector, except that each element
+//! of the vector - a "bucket" - also contains a copy of the first
+//! `PrefixSlots` entries of the v-table. When a method's slot falls in that
+//! range, method dispatch reads the function pointer (or dispatch table
+//! pointer) directly from the bucket, instead of following the v-table
+//! pointer. With the default value of `PrefixSlots`, a bucket fills a single
+//! 64-byte cache line on 64-bit platforms.
+//!
+//! The buckets are rebuilt by @ref initialize, each time it is called.
+//!
+//! @tparam PrefixSlots The number of v-table entries copied in each bucket.
+template<std::size_t PrefixSlots = 7>
+struct vptr_prefix_vector : vptr {
+    static_assert(PrefixSlots > 0, "use vptr_vector instead");
+
+    //! A VptrFn metafunction.
+    //!
+    //! @tparam Registry The registry containing this policy.
+    template<class Registry>
+    struct fn {
+        using type_hash =
+            typename Registry::template policy<policies::type_hash>;
+        static constexpr auto has_type_hash = !std::is_same_v<type_hash, void>;
+
+        //! The number of v-table entries copied in each bucket.
+        static constexpr std::size_t prefix_slots = PrefixSlots;
+
+        //! The type of the elements of the vector.
+        using bucket = detail::vptr_prefix_bucket<
+            std::conditional_t<
+                Registry::has_indirect_vptr, const vptr_type*, vptr_type>,
+            PrefixSlots>;
+
+        //! Stores the v-table pointers and the v-table prefixes.
+        //!
+        //! If `Registry` contains a @ref type_hash policy, its `initialize`
+        //! function is called. Its result determines the size of the vector.
+        //!
+        //! @tparam Context An @ref InitializeContext.
+        //! @tparam Options... Zero or more option types.
+        //! @param ctx A Context object.
+        //! @param options A tuple of option objects.
+        template<class Context, class... Options>
+        static auto initialize(
+            const Context& ctx, const std::tuple<Options...>& options) -> void {
+            std::size_t size;
+            (void)options;
+
+            if constexpr (has_type_hash) {
+                auto [_, max_value] = type_hash::initialize(ctx, options);
+                size = max_value + 1;
+            } else {
+                size = 0;
+
+                for (auto iter = ctx.classes_begin(); iter != ctx.classes_end();
+                     ++iter) {
+                    for (auto type_iter = iter->type_id_begin();
+                         type_iter != iter->type_id_end(); ++type_iter) {
+                        size = (std::max)(size, std::size_t(*type_iter));
+                    }
+                }
+
+                ++size;
+            }
+
+            detail::runtime_vector<bucket, Registry> buckets(size);
+
+            for (auto iter = ctx.classes_begin(); iter != ctx.classes_end();
+                 ++iter) {
+                bucket entry{};
+
+                if constexpr (Registry::has_indirect_vptr) {
+                    entry.vptr = &iter->vptr();
+                } else {
+                    entry.vptr = iter->vptr();
+                }
+
+                // Copy only the entries that belong to the class. The slots
+                // below `slots_begin()` are used by unrelated classes, in
+                // multiple inheritance lattices.
+                auto last = (std::min)(iter->slots_end(), PrefixSlots);
+
+                for (auto slot = iter->slots_begin(); slot < last; ++slot) {
+                    entry.prefix[slot] = iter->vptr()[slot];
+                }
+
+                for (auto type_iter = iter->type_id_begin();
+                     type_iter != iter->type_id_end(); ++type_iter) {
+                    std::size_t index;
+
+                    if constexpr (has_type_hash) {
+                        index = type_hash::hash(*type_iter);
+                    } else {
+                        index = std::size_t(*type_iter);
+                    }
+
+                    buckets[index] = entry;
+                }
+            }
+
+            detail::vptr_prefix_vector_buckets<Registry, bucket>.swap(buckets);
+        }
+
+        //! Returns a *reference* to a v-table pointer for an object.
+        //!
+        //! Acquires the dynamic @ref type_id of `arg`, using the registry's
+        //! @ref rtti policy, and converts it to an index, in the same way as
+        //! @ref vptr_vector.
+        //!
+        //! @tparam Class A registered class.
+        //! @param arg A reference to a const object of type `Class`.
+        //! @return A reference to a the v-table pointer for `Class`.
+        template<class Class>
+        static auto dynamic_vptr(const Class& arg) -> const vptr_type& {
+            if constexpr (Registry::has_indirect_vptr) {
+                return *dynamic_bucket(arg).vptr;
+            } else {
+                return dynamic_bucket(arg).vptr;
+            }
+        }
+
+        //! Returns an entry in the v-table of an object.
+        //!
+        //! If `slot` is less than `PrefixSlots`, reads the entry from the
+        //! bucket; otherwise, reads it from the v-table.
+        //!
+        //! @tparam Class A registered class.
+        //! @param arg A reference to a const object of type `Class`.
+        //! @param slot An index in the v-table.
+        //! @return The v-table entry.
+        template<class Class>
+        static auto
+        dynamic_slot(const Class& arg, std::size_t slot) -> detail::word {
+            auto& entry = dynamic_bucket(arg);
+
+            if (slot < PrefixSlots) {
+                return entry.prefix[slot];
+            }
+
+            if constexpr (Registry::has_indirect_vptr) {
+                return (*entry.vptr)[slot];
+            } else {
+                return entry.vptr[slot];
+            }
+        }
+
+        //! Releases the memory allocated by `initialize`.
+        //!
+        //! @tparam Options... Zero or more option types, deduced from the
+        //! function arguments.
+        //! @param options Zero or more option objects.
+        template<class... Options>
+        static auto finalize(const std::tuple<Options...>&) -> void {
+            detail::vptr_prefix_vector_buckets<Registry, bucket>.clear();
+        }
+
+      private:
+        template<class Class>
+        static auto dynamic_bucket(const Class& arg) -> const bucket& {
+            auto& buckets =
+                detail::vptr_prefix_vector_buckets<Registry, bucket>;
+            auto dynamic_type = Registry::rtti::dynamic_type(arg);
+            std::size_t index;
+
+            if constexpr (has_type_hash) {
+                index = type_hash::hash(dynamic_type);
+            } else {
+                index = std::size_t(dynamic_type);
+
+                if constexpr (Registry::has_runtime_checks) {
+                    if (index >= buckets.size()) {
+                        if constexpr (Registry::has_error_handler) {
+                            missing_class error;
+                            error.type = dynamic_type;
+                            Registry::error_handler::error(error);
+                        }
+
+                        abort();
+                    }
+                }
+            }
+
+            return buckets[index];
+        }
+    };
+};
+
+} // namespace policies
+} // namespace boost::openmethod
+
+#endif
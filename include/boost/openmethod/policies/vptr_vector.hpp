@@ -16,10 +16,10 @@ namespace boost::openmethod {
 namespace detail {
 
 template<class Registry>
-inline std::vector<vptr_type> vptr_vector_vptrs;
+inline runtime_vector<vptr_type, Registry> vptr_vector_vptrs;
 
 template<class Registry>
-inline std::vector<const vptr_type*> vptr_vector_indirect_vptrs;
+inline runtime_vector<const vptr_type*, Registry> vptr_vector_indirect_vptrs;
 
 } // namespace detail
 
@@ -85,11 +85,11 @@ struct vptr_vector : vptr {
                 ++size;
             }
 
-            if constexpr (Registry::has_indirect_vptr) {
-                detail::vptr_vector_indirect_vptrs<Registry>.resize(size);
-            } else {
-                detail::vptr_vector_vptrs<Registry>.resize(size);
-            }
+            using vector_type = std::conditional_t<
+                Registry::has_indirect_vptr,
+                detail::runtime_vector<const vptr_type*, Registry>,
+                detail::runtime_vector<vptr_type, Registry>>;
+            vector_type vptrs(size);
 
             for (auto iter = ctx.classes_begin(); iter != ctx.classes_end();
                  ++iter) {
@@ -104,14 +104,18 @@ struct vptr_vector : vptr {
                     }
 
                     if constexpr (Registry::has_indirect_vptr) {
-                        detail::vptr_vector_indirect_vptrs<Registry>[index] =
-                            &iter->vptr();
+                        vptrs[index] = &iter->vptr();
                     } else {
-                        detail::vptr_vector_vptrs<Registry>[index] =
-                            iter->vptr();
+                        vptrs[index] = iter->vptr();
                     }
                 }
             }
+
+            if constexpr (Registry::has_indirect_vptr) {
+                detail::vptr_vector_indirect_vptrs<Registry>.swap(vptrs);
+            } else {
+                detail::vptr_vector_vptrs<Registry>.swap(vptrs);
+            }
         }
 
         //! Returns a *reference* to a v-table pointer for an object.
@@ -7,8 +7,13 @@
 #include <boost/mp11/bind.hpp>
 
 #include <stdlib.h>
+#include <algorithm>
+#include <chrono>
+#include <limits>
+#include <memory>
 #include <vector>
 #include <cstdint>
+#include <string>
 #include <string_view>
 
 #ifdef _MSC_VER
@@ -35,6 +40,17 @@ union word {
     word* pw;
 };
 
+// With the class_intervals policy, the words in front of a v-table contain, in
+// this order: a pointer to a bitmap of the numbers of the subclasses, or null;
+// the end of the interval of numbers of the subclasses; the number of the
+// class.
+constexpr std::ptrdiff_t class_bitmap = -3;
+constexpr std::ptrdiff_t class_end = -2;
+constexpr std::ptrdiff_t class_number = -1;
+constexpr std::size_t class_header_size = 3;
+constexpr std::size_t bits_per_word =
+    std::numeric_limits<std::size_t>::digits;
+
 } // namespace detail
 
 //! Alias to v-table pointer type.
@@ -339,9 +355,14 @@ struct method_info : static_list<method_info>::static_link {
     static_list<overrider_info> overriders;
     void (*not_implemented)();
     void (*ambiguous)();
+    // Same, with the signature of `next` pointers.
+    void (*next_not_implemented)();
+    void (*next_ambiguous)();
     type_id method_type_id;
     type_id return_type_id;
     std::size_t* slots_strides_ptr;
+    // Set by initialize if all the calls resolve to the same overrider.
+    void (*monomorphic)();
 
     auto arity() const {
         return std::distance(vp_begin, vp_end);
@@ -363,6 +384,7 @@ struct overrider_info : static_list<overrider_info>::static_link {
     void (**next)();
     type_id *vp_begin, *vp_end;
     void (*pf)();
+    void (*next_pf)(); // same, with the signature of `next` pointers
 };
 
 struct deferred_overrider_info : overrider_info {
@@ -412,6 +434,54 @@ struct LightweightOutputStream {
 //!   the same program.
 struct n2216 {};
 
+//! Return the compiler from `initialize`.
+//!
+//! By default, @ref initialize destroys the objects used to build the dispatch
+//! tables before returning, and returns only a report. If `retain_compiler` is
+//! passed to `initialize`, it returns the whole compiler object instead, which
+//! can be used to inspect the classes, methods and slots, at the cost of
+//! keeping its memory alive.
+//!
+//! The compiler's containers allocate from the registry's scratch storage,
+//! which, for @ref policies::static_arena, is a buffer used as a stack. A
+//! retained compiler pins its blocks until it is destroyed; meanwhile, later
+//! calls to `initialize` allocate their temporary data above them.
+struct retain_compiler {};
+
+//! Use a dispatch profile to lay out the v-tables and dispatch tables.
+//!
+//! If `profile` is passed to @ref initialize, the file at `path`, written by
+//! @ref policies::dispatch_profiler::fn::save, is read, and used to:
+//!
+//! @li assign the lowest slots to the most frequently called methods,
+//! @li place the v-tables of the most frequently used classes, and the dispatch
+//! tables of the most frequently called multi-methods, first in the dispatch
+//! data.
+//!
+//! Entries that do not match a method or a class in the registry are ignored.
+//! If the file cannot be read, the default layout is used.
+struct profile {
+    //! The path of the profile file.
+    std::string path;
+};
+
+//! Set the time budget of the v-table slot optimizer.
+//!
+//! In hierarchies that use multiple inheritance, @ref initialize first assigns
+//! v-table slots greedily, then tries to find an assignment that uses fewer
+//! v-table entries in total. If the optimizer exceeds its budget, the greedy
+//! assignment is kept. A budget of zero disables the optimizer. The default
+//! budget is 10 milliseconds.
+struct slot_budget {
+    //! The maximum time spent optimizing the slot assignment.
+    std::chrono::microseconds duration;
+
+    slot_budget(
+        std::chrono::microseconds duration = std::chrono::milliseconds(10))
+        : duration(duration) {
+    }
+};
+
 //! Enable `initialize` tracing.
 //!
 //! If `trace` is passed to @ref initialize, tracing code is added to various
@@ -486,6 +556,16 @@ struct InitializeClass {
     //!
     //! @return A reference to the v-table pointer for the class.
     auto vptr() const -> const vptr_type&;
+
+    //! Index of the first slot used in the class' v-table.
+    //!
+    //! @return The index of the first valid entry in `vptr()`.
+    auto slots_begin() const -> std::size_t;
+
+    //! Index past the last slot used in the class' v-table.
+    //!
+    //! @return The index one past the last valid entry in `vptr()`.
+    auto slots_end() const -> std::size_t;
 };
 
 //! Context for initializing a policy (exposition only).
@@ -704,6 +784,62 @@ struct indirect_vptr final {
     struct fn {};
 };
 
+//! Policy to number classes, for constant-time subtype tests.
+//!
+//! If this policy is present, @ref initialize numbers the classes in
+//! depth-first preorder, and stores, in front of each v-table, the number of
+//! the class, and the end of the interval of numbers covered by its
+//! subclasses. If multiple inheritance makes the interval include classes that
+//! are not subclasses, a bitmap of the subclasses is stored as well. This
+//! enables @ref is_a and @ref fast_cast.
+//!
+//! Since the v-tables carry per-class data, classes do not share v-tables
+//! under this policy.
+struct class_intervals final {
+    // Policy category.
+    using category = class_intervals;
+    template<class Registry>
+    struct fn {};
+};
+
+//! Policy to store class numbers instead of v-table pointers in objects.
+//!
+//! If this policy is present, @ref inplace_vptr_base embeds a 32-bit class
+//! number in objects, instead of a v-table pointer. The v-table pointer is
+//! looked up in @ref registry::class_vptrs. The number remains valid after a
+//! new call to @ref initialize, without the indirection of @ref indirect_vptr,
+//! provided that the same classes are registered. Class numbers are assigned
+//! in depth-first order, so registering more classes, e.g. from a dynamically
+//! loaded library, renumbers existing classes.
+//!
+//! Requires the @ref class_intervals policy.
+struct compact_inplace_vptr final {
+    // Policy category.
+    using category = compact_inplace_vptr;
+    template<class Registry>
+    struct fn {};
+};
+
+//! Policy to set the v-table pointers embedded in objects only once.
+//!
+//! By default, the constructor of each @ref inplace_vptr_base and @ref
+//! inplace_vptr_derived in a hierarchy sets the v-table pointer to its own
+//! class, and the destructors restore it, level by level. This makes it
+//! possible to call methods from constructors and destructors.
+//!
+//! If this policy is present, only the constructors of `final` classes set the
+//! v-table pointer, once per root class, and destructors leave it alone. Only
+//! `final` classes can be instantiated, and methods cannot be called on the
+//! object until its most derived constructor has run. If the registry contains
+//! the @ref runtime_checks policy, using an object whose v-table pointer is not
+//! set is reported as a @ref missing_class error.
+struct final_inplace_vptr final {
+    // Policy category.
+    using category = final_inplace_vptr;
+    template<class Registry>
+    struct fn {};
+};
+
 #ifdef __MRDOCS__
 //! Blueprint for @ref type_hash metafunctions (exposition only).
 //!
@@ -780,6 +916,130 @@ struct output {
     using category = output;
 };
 
+#ifdef __MRDOCS__
+
+//! Blueprint for @ref arena metafunctions (exposition only).
+//!
+//! @tparam Registry The registry containing the policy.
+template<class Registry>
+struct ArenaFn {
+    //! Prepare the arena for a new set of runtime data.
+    //!
+    //! Called by @ref initialize before it writes the dispatch data. The
+    //! memory returned by previous calls to `allocate` may be reused.
+    static auto begin_update() -> void;
+
+    //! Allocate a block of memory.
+    //!
+    //! @param size The size of the block, in bytes.
+    //! @param alignment The alignment of the block.
+    //! @return A pointer to the block.
+    static auto allocate(std::size_t size, std::size_t alignment) -> void*;
+
+    //! Signal that the runtime data is complete.
+    //!
+    //! Called by @ref initialize after it has written the dispatch data, and
+    //! the vptr policy has been initialized.
+    static auto end_update() -> void;
+
+    //! Allocate a block of memory for the temporary data of @ref initialize.
+    //!
+    //! This function is optional. If it is present, @ref initialize, and the
+    //! stock policies, allocate their temporary data structures with it,
+    //! instead of the heap.
+    //!
+    //! @param size The size of the block, in bytes.
+    //! @param alignment The alignment of the block.
+    //! @return A pointer to the block.
+    static auto scratch_allocate(std::size_t size, std::size_t alignment)
+        -> void*;
+
+    //! Release a block allocated by `scratch_allocate`.
+    //!
+    //! Required if `scratch_allocate` is present.
+    //!
+    //! @param p A pointer returned by `scratch_allocate`.
+    //! @param size The size of the block, in bytes.
+    static auto scratch_deallocate(void* p, std::size_t size) -> void;
+
+    //! Release the memory held by the arena.
+    //!
+    //! This function is optional.
+    //!
+    //! @tparam Options... Zero or more option types, deduced from the
+    //! function arguments.
+    //! @param options A tuple of option objects.
+    template<class... Options>
+    static auto finalize(const std::tuple<Options...>& options) -> void;
+};
+
+#endif
+
+//! Policy for allocating the runtime dispatch data.
+//!
+//! If an `arena` policy is present, the dispatch tables and v-tables, and the
+//! tables of the stock @ref vptr and @ref type_hash policies, are allocated
+//! from it, instead of the heap. The memory is allocated during @ref
+//! initialize, and never freed individually.
+//!
+//! @par Requirements
+//!
+//! Classes implementing this policy must:
+//! @li derive from `arena`.
+//! @li provide a `fn<Registry>` metafunction that conforms to the @ref
+//! ArenaFn blueprint.
+struct arena {
+    // Policy category.
+    using category = arena;
+};
+
+#ifdef __MRDOCS__
+
+//! Blueprint for @ref profiler metafunctions (exposition only).
+//!
+//! @tparam Registry The registry containing the policy.
+template<class Registry>
+struct ProfilerFn {
+    //! Prepare for a new set of runtime data.
+    //!
+    //! Called by @ref initialize after the v-tables have been written.
+    //!
+    //! @tparam Context An @ref InitializeContext.
+    //! @tparam Options... Zero or more option types.
+    //! @param ctx A Context object.
+    //! @param options A tuple of option objects.
+    template<class Context, class... Options>
+    static auto initialize(
+        const Context& ctx, const std::tuple<Options...>& options) -> void;
+
+    //! Record the dispatch of a virtual argument.
+    //!
+    //! @param method The method being called.
+    //! @param param The index of the argument, among the virtual arguments.
+    //! @param vptr The v-table pointer of the argument.
+    static auto record(
+        const detail::method_info& method, std::size_t param, vptr_type vptr)
+        -> void;
+};
+
+#endif
+
+//! Policy for profiling method dispatch.
+//!
+//! If a `profiler` policy is present, its `record` function is called for each
+//! virtual argument of each method call.
+//!
+//! @par Requirements
+//!
+//! Classes implementing this policy must:
+//! @li derive from `profiler`.
+//! @li provide a `fn<Registry>` metafunction that conforms to the @ref
+//! ProfilerFn blueprint.
+struct profiler {
+    // Policy category.
+    using category = profiler;
+};
+
 //! Policy for post-initialize runtime checks.
 //!
 //! If this policy is present, performs the following checks:
@@ -818,6 +1078,118 @@ struct get_policy_aux<Registry, Size, Size> {
     using type = void;
 };
 
+// Alignment of the blocks allocated from an arena policy.
+constexpr std::size_t cache_line_size = 64;
+
+// Allocates from the registry's arena policy if it has one, otherwise from the
+// heap. Deallocation from an arena is a no-op.
+template<class T, class Registry>
+struct runtime_allocator {
+    using value_type = T;
+
+    runtime_allocator() = default;
+
+    template<class U>
+    runtime_allocator(const runtime_allocator<U, Registry>&) noexcept {
+    }
+
+    template<class U>
+    struct rebind {
+        using other = runtime_allocator<U, Registry>;
+    };
+
+    auto allocate(std::size_t n) -> T* {
+        if constexpr (Registry::has_arena) {
+            return static_cast<T*>(Registry::arena::allocate(
+                n * sizeof(T), (std::max)(alignof(T), cache_line_size)));
+        } else {
+            return std::allocator<T>().allocate(n);
+        }
+    }
+
+    void deallocate(T* p, std::size_t n) noexcept {
+        if constexpr (!Registry::has_arena) {
+            std::allocator<T>().deallocate(p, n);
+        } else {
+            (void)p;
+            (void)n;
+        }
+    }
+
+    template<class U>
+    auto operator==(const runtime_allocator<U, Registry>&) const noexcept {
+        return true;
+    }
+
+    template<class U>
+    auto operator!=(const runtime_allocator<U, Registry>&) const noexcept {
+        return false;
+    }
+};
+
+// Containers for the runtime data of a registry. They must be rebuilt, not
+// resized in place, on each call to `initialize`, because an arena may recycle
+// the memory allocated by the previous call.
+template<class T, class Registry>
+using runtime_vector = std::vector<T, runtime_allocator<T, Registry>>;
+
+// Memory for the temporary data structures of `initialize`.
+struct scratch_resource {
+    void* (*allocate)(std::size_t size, std::size_t alignment);
+    void (*deallocate)(void* p, std::size_t size);
+};
+
+// The resource used by the scratch allocators constructed from now on, by this
+// thread, or null to use the heap. Set by `initialize`, for the duration of the
+// call. Thread-local, so that registries can be initialized concurrently.
+inline thread_local const scratch_resource* current_scratch = nullptr;
+
+// Allocates from the scratch resource that was current when the allocator, or
+// the allocator it was copied from, was constructed.
+template<class T>
+struct scratch_allocator {
+    using value_type = T;
+
+    const scratch_resource* resource = current_scratch;
+
+    scratch_allocator() = default;
+
+    template<class U>
+    scratch_allocator(const scratch_allocator<U>& other) noexcept
+        : resource(other.resource) {
+    }
+
+    auto allocate(std::size_t n) -> T* {
+        if (resource) {
+            return static_cast<T*>(
+                resource->allocate(n * sizeof(T), alignof(T)));
+        }
+
+        return std::allocator<T>().allocate(n);
+    }
+
+    void deallocate(T* p, std::size_t n) noexcept {
+        if (resource) {
+            resource->deallocate(p, n * sizeof(T));
+        } else {
+            std::allocator<T>().deallocate(p, n);
+        }
+    }
+
+    template<class U>
+    auto operator==(const scratch_allocator<U>& other) const noexcept {
+        return resource == other.resource;
+    }
+
+    template<class U>
+    auto operator!=(const scratch_allocator<U>& other) const noexcept {
+        return resource != other.resource;
+    }
+};
+
+template<class T>
+using scratch_vector = std::vector<T, scratch_allocator<T>>;
+
 using class_catalog = detail::static_list<detail::class_info>;
 using method_catalog = detail::static_list<detail::method_info>;
 
@@ -928,7 +1300,7 @@ class registry : detail::registry_base {
     template<typename Name, typename ReturnType, class Registry>
     friend class method;
 
-    static std::vector<detail::word> dispatch_data;
+    static detail::runtime_vector<detail::word, registry> dispatch_data;
     static bool initialized;
 
   public:
@@ -961,6 +1333,13 @@ class registry : detail::registry_base {
     template<class Class>
     static vptr_type static_vptr;
 
+    //! The v-table pointers of the registered classes, by class number.
+    //!
+    //! If the registry contains the @ref class_intervals policy, `class_vptrs`
+    //! is filled by @ref registry::initialize, and indexed by the numbers
+    //! stored in front of the v-tables. Otherwise, it is empty.
+    static detail::runtime_vector<vptr_type, registry> class_vptrs;
+
     //! List of policies selected in a registry.
     //!
     //! `policy_list` is a Boost.Mp11 list containing the policies passed to the
@@ -1038,6 +1417,30 @@ class registry : detail::registry_base {
     //! `true` if the registry has an indirect_vptr policy.
     static constexpr auto has_indirect_vptr =
         !std::is_same_v<policy<policies::indirect_vptr>, void>;
+
+    //! `true` if the registry has a class_intervals policy.
+    static constexpr auto has_class_intervals =
+        !std::is_same_v<policy<policies::class_intervals>, void>;
+
+    //! `true` if the registry has a compact_inplace_vptr policy.
+    static constexpr auto has_compact_inplace_vptr =
+        !std::is_same_v<policy<policies::compact_inplace_vptr>, void>;
+
+    //! `true` if the registry has a final_inplace_vptr policy.
+    static constexpr auto has_final_inplace_vptr =
+        !std::is_same_v<policy<policies::final_inplace_vptr>, void>;
+
+    //! The registry's arena policy if it contains one, or `void`.
+    using arena = policy<policies::arena>;
+
+    //! `true` if the registry has an arena policy.
+    static constexpr auto has_arena = !std::is_same_v<arena, void>;
+
+    //! The registry's profiler policy if it contains one, or `void`.
+    using profiler = policy<policies::profiler>;
+
+    //! `true` if the registry has a profiler policy.
+    static constexpr auto has_profiler = !std::is_same_v<profiler, void>;
 };
 
 template<class... Policies>
@@ -1047,7 +1450,8 @@ template<class... Policies>
 detail::method_catalog registry<Policies...>::methods;
 
 template<class... Policies>
-std::vector<detail::word> registry<Policies...>::dispatch_data;
+detail::runtime_vector<detail::word, registry<Policies...>>
+    registry<Policies...>::dispatch_data;
 
 template<class... Policies>
 bool registry<Policies...>::initialized;
@@ -1056,6 +1460,10 @@ template<class... Policies>
 template<class Class>
 vptr_type registry<Policies...>::static_vptr;
 
+template<class... Policies>
+detail::runtime_vector<vptr_type, registry<Policies...>>
+    registry<Policies...>::class_vptrs;
+
 template<class... Policies>
 void registry<Policies...>::require_initialized() {
     if constexpr (registry::has_runtime_checks) {
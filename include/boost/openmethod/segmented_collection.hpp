@@ -0,0 +1,227 @@
+// Copyright (c) 2018-2025 Jean-Louis Leroy
+// Distributed under the Boost Software License, Version 1.0.
+// See accompanying file LICENSE_1_0.txt
+// or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_OPENMETHOD_SEGMENTED_COLLECTION_HPP
+#define BOOST_OPENMETHOD_SEGMENTED_COLLECTION_HPP
+
+#include <boost/openmethod/core.hpp>
+
+#include <cstddef>
+#include <memory>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace boost::openmethod {
+
+//! Polymorphic collection that stores objects by value, grouped by class.
+//!
+//! `segmented_collection` stores objects of classes derived from `Base` in
+//! contiguous segments, one per class, in the order in which the classes are
+//! first inserted. Each segment knows the v-table of its class, so iterating
+//! over a segment does not involve looking up v-tables, and a method call can
+//! be resolved once per segment, via @ref method::for_each.
+//!
+//! Like with `std::vector`, inserting an object may move the other objects of
+//! the same class, and invalidate references to them.
+//!
+//! @par Requirements
+//!
+//! @li `Base` must be a class registered in `Registry`.
+//! @li The classes of the objects must be registered in `Registry`, and be
+//! move-constructible.
+//! @li `Registry` must be initialized before calling `for_each`.
+//!
+//! @tparam Base The base class of the objects in the collection.
+//! @tparam Registry The registry in which the classes are registered.
+template<class Base, class Registry = BOOST_OPENMETHOD_DEFAULT_REGISTRY>
+class segmented_collection {
+    using boxed_vptr = decltype(detail::box_vptr<Registry::has_indirect_vptr>(
+        std::declval<const vptr_type&>()));
+
+    class segment_base {
+      public:
+        virtual ~segment_base() = default;
+        virtual auto data() -> char* = 0;
+        virtual auto size() const -> std::size_t = 0;
+
+        const vptr_type* static_vptr = nullptr;
+        std::size_t stride = 0;
+        // Offset of the Base subobject in the objects.
+        std::ptrdiff_t offset = 0;
+    };
+
+    template<class Class>
+    class segment : public segment_base {
+      public:
+        std::vector<Class> objects;
+
+        auto data() -> char* override {
+            return reinterpret_cast<char*>(objects.data());
+        }
+
+        auto size() const -> std::size_t override {
+            return objects.size();
+        }
+    };
+
+    // Iterates over the objects of a segment, as `virtual_ptr`s.
+    template<class Element>
+    class segment_iterator {
+        char* p;
+        std::size_t stride;
+        std::ptrdiff_t offset;
+        boxed_vptr vp;
+
+      public:
+        segment_iterator(
+            char* p, std::size_t stride, std::ptrdiff_t offset, boxed_vptr vp)
+            : p(p), stride(stride), offset(offset), vp(vp) {
+        }
+
+        auto operator*() const -> virtual_ptr<Element, Registry> {
+            return virtual_ptr<Element, Registry>(
+                *reinterpret_cast<Element*>(p + offset), vp);
+        }
+
+        auto operator++() -> segment_iterator& {
+            p += stride;
+            return *this;
+        }
+
+        auto operator==(const segment_iterator& other) const -> bool {
+            return p == other.p;
+        }
+
+        auto operator!=(const segment_iterator& other) const -> bool {
+            return p != other.p;
+        }
+    };
+
+    std::vector<std::unique_ptr<segment_base>> segments;
+    std::unordered_map<type_id, segment_base*> index;
+    std::size_t count = 0;
+
+    template<class Class>
+    auto find_segment() -> segment<Class>& {
+        auto type = Registry::rtti::template static_type<Class>();
+        auto iter = index.find(type);
+
+        if (iter != index.end()) {
+            return static_cast<segment<Class>&>(*iter->second);
+        }
+
+        auto seg = std::make_unique<segment<Class>>();
+        seg->static_vptr = &Registry::template static_vptr<Class>;
+        seg->stride = sizeof(Class);
+        auto& result = *seg;
+        index.emplace(type, seg.get());
+        segments.push_back(std::move(seg));
+
+        return result;
+    }
+
+    template<class Element, class Method, typename... Args>
+    auto for_each_aux(const Method& method, Args&&... args) const -> void {
+        for (auto& seg : segments) {
+            auto first = seg->data();
+            auto vp = detail::box_vptr<Registry::has_indirect_vptr>(
+                *seg->static_vptr);
+            segment_iterator<Element> begin(
+                first, seg->stride, seg->offset, vp);
+            segment_iterator<Element> end(
+                first + seg->stride * seg->size(), seg->stride, seg->offset,
+                vp);
+            method.for_each(begin, end, args...);
+        }
+    }
+
+  public:
+    //! Construct an object at the end of its class' segment
+    //!
+    //! @tparam Class The class of the object, derived from `Base`.
+    //! @tparam Args The types of the arguments to the constructor.
+    //! @param args The arguments to pass to the constructor.
+    //! @return A reference to the new object.
+    template<class Class, typename... Args>
+    auto emplace(Args&&... args) -> Class& {
+        static_assert(
+            std::is_base_of_v<Base, Class>, "Class must derive from Base");
+
+        auto& seg = find_segment<Class>();
+        auto& obj = seg.objects.emplace_back(std::forward<Args>(args)...);
+        ++count;
+
+        if (seg.objects.size() == 1) {
+            seg.offset = reinterpret_cast<char*>(static_cast<Base*>(&obj)) -
+                reinterpret_cast<char*>(&obj);
+        }
+
+        return obj;
+    }
+
+    //! Copy or move an object at the end of its class' segment
+    //!
+    //! The object is inserted in the segment of its static class.
+    //!
+    //! @param obj The object to insert.
+    //! @return A reference to the new object.
+    template<class Class>
+    auto insert(Class&& obj) -> std::decay_t<Class>& {
+        return emplace<std::decay_t<Class>>(std::forward<Class>(obj));
+    }
+
+    //! Call a method for each object in the collection
+    //!
+    //! Call `method` for each object, as its first argument, followed by
+    //! `args`. The objects are passed as `virtual_ptr`s, or as references if
+    //! the first parameter of `method` is not a `virtual_ptr`. The call is
+    //! resolved once per segment.
+    //!
+    //! @param method A method, whose first parameter is virtual.
+    //! @param args The remaining arguments, passed as lvalues to each call.
+    template<class Method, typename... Args>
+    auto for_each(const Method& method, Args&&... args) -> void {
+        for_each_aux<Base>(method, args...);
+    }
+
+    //! Call a method for each object in the collection
+    //!
+    //! Same as the non-const overload, except that the objects are passed as
+    //! `virtual_ptr<const Base>`s or references to `const Base`.
+    //!
+    //! @param method A method, whose first parameter is virtual.
+    //! @param args The remaining arguments, passed as lvalues to each call.
+    template<class Method, typename... Args>
+    auto for_each(const Method& method, Args&&... args) const -> void {
+        for_each_aux<const Base>(method, args...);
+    }
+
+    //! Return the number of objects in the collection
+    auto size() const -> std::size_t {
+        return count;
+    }
+
+    //! Return `true` if the collection contains no objects
+    auto empty() const -> bool {
+        return count == 0;
+    }
+
+    //! Return the number of segments, i.e. of distinct classes
+    auto segment_count() const -> std::size_t {
+        return segments.size();
+    }
+
+    //! Destroy all the objects in the collection
+    auto clear() -> void {
+        segments.clear();
+        index.clear();
+        count = 0;
+    }
+};
+
+} // namespace boost::openmethod
+
+#endif
@@ -0,0 +1,175 @@
+// Copyright (c) 2018-2025 Jean-Louis Leroy
+// Distributed under the Boost Software License, Version 1.0.
+// See accompanying file LICENSE_1_0.txt
+// or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_OPENMETHOD_VIRTUAL_PTR_VECTOR_HPP
+#define BOOST_OPENMETHOD_VIRTUAL_PTR_VECTOR_HPP
+
+#include <boost/openmethod/core.hpp>
+
+#include <cstddef>
+#include <vector>
+
+namespace boost::openmethod {
+
+//! Vector of `virtual_ptr`s, stored as two parallel arrays.
+//!
+//! `virtual_ptr_vector` stores the object pointers and the v-table pointers of
+//! a sequence of @ref virtual_ptr{empty}s in two separate arrays.
+//! `virtual_ptr`s are reconstructed on demand, without acquiring the v-table
+//! pointers again. @ref for_each calls a method on the elements by batches:
+//! it resolves the calls for a batch from the v-table pointers, while
+//! prefetching the objects, then calls the overriders.
+//!
+//! The vector does not own the objects.
+//!
+//! @tparam Class A registered class, possibly cv-qualified.
+//! @tparam Registry The registry in which `Class` is registered.
+template<class Class, class Registry = BOOST_OPENMETHOD_DEFAULT_REGISTRY>
+class virtual_ptr_vector {
+    using boxed_vptr = decltype(detail::box_vptr<Registry::has_indirect_vptr>(
+        std::declval<const vptr_type&>()));
+
+    std::vector<Class*> objects;
+    std::vector<boxed_vptr> vptrs;
+
+  public:
+    //! The type of the elements, as returned by `operator[]`.
+    using value_type = virtual_ptr<Class, Registry>;
+
+    //! Iterator over the elements, as `virtual_ptr`s.
+    class const_iterator {
+        const virtual_ptr_vector* vec;
+        std::size_t index;
+
+      public:
+        const_iterator(const virtual_ptr_vector* vec, std::size_t index)
+            : vec(vec), index(index) {
+        }
+
+        auto operator*() const -> value_type {
+            return (*vec)[index];
+        }
+
+        auto operator++() -> const_iterator& {
+            ++index;
+            return *this;
+        }
+
+        auto operator==(const const_iterator& other) const -> bool {
+            return index == other.index;
+        }
+
+        auto operator!=(const const_iterator& other) const -> bool {
+            return index != other.index;
+        }
+    };
+
+    //! Append a `virtual_ptr`
+    //!
+    //! The v-table pointer is copied from `ptr`, not acquired again.
+    //!
+    //! @param ptr A `virtual_ptr` to an object of a class convertible to
+    //! `Class`.
+    template<
+        class Other,
+        typename = std::enable_if_t<std::is_constructible_v<Class*, Other*>>>
+    auto push_back(const virtual_ptr<Other, Registry>& ptr) -> void {
+        objects.push_back(ptr.get());
+        vptrs.push_back(ptr.vp);
+    }
+
+    //! Append a reference to an object
+    //!
+    //! The v-table pointer is obtained as for a @ref virtual_ptr.
+    //!
+    //! @param obj A reference to a polymorphic object.
+    template<
+        class Other,
+        typename = std::enable_if_t<
+            std::is_constructible_v<Class*, Other*> &&
+            std::is_polymorphic_v<Other>>>
+    auto push_back(Other& obj) -> void {
+        push_back(virtual_ptr<Class, Registry>(obj));
+    }
+
+    //! Remove the last element
+    auto pop_back() -> void {
+        objects.pop_back();
+        vptrs.pop_back();
+    }
+
+    //! Return a `virtual_ptr` to the `i`-th object
+    //!
+    //! @param i The index of the element.
+    //! @return A `virtual_ptr<Class, Registry>`.
+    auto operator[](std::size_t i) const -> value_type {
+        return value_type(*objects[i], vptrs[i]);
+    }
+
+    //! Return an iterator to the first element
+    auto begin() const -> const_iterator {
+        return const_iterator(this, 0);
+    }
+
+    //! Return an iterator past the last element
+    auto end() const -> const_iterator {
+        return const_iterator(this, size());
+    }
+
+    //! Call a method for each element
+    //!
+    //! Call `method` with each element, as a `virtual_ptr`, followed by `args`.
+    //! The elements are processed by batches of 16. For each batch, the calls
+    //! are resolved first, reading the v-table pointers from a contiguous
+    //! array, and the objects are prefetched. Then the overriders are called,
+    //! in order.
+    //!
+    //! @param method A method whose first parameter is a `virtual_ptr` to
+    //! `Class`, or to one of its bases.
+    //! @param args The remaining arguments, passed as lvalues to each call.
+    template<class Method, typename... Args>
+    auto for_each(const Method& method, Args&&... args) const -> void {
+        static_assert(
+            sizeof...(Args) + 1 ==
+                mp11::mp_size<typename Method::DeclaredParameters>::value,
+            "wrong number of arguments");
+
+        auto objs = objects.data();
+        auto vps = vptrs.data();
+
+        method.for_each_batched(
+            typename Method::DeclaredParameters(), objects.size(),
+            [objs, vps](std::size_t i) { return value_type(*objs[i], vps[i]); },
+            args...);
+    }
+
+    //! Return the number of elements
+    auto size() const -> std::size_t {
+        return objects.size();
+    }
+
+    //! Return `true` if the vector is empty
+    auto empty() const -> bool {
+        return objects.empty();
+    }
+
+    //! Reserve storage for `n` elements
+    //!
+    //! @param n The number of elements.
+    auto reserve(std::size_t n) -> void {
+        objects.reserve(n);
+        vptrs.reserve(n);
+    }
+
+    //! Remove all the elements
+    auto clear() -> void {
+        objects.clear();
+        vptrs.clear();
+    }
+};
+
+} // namespace boost::openmethod
+
+#endif
@@ -0,0 +1,154 @@
+// Copyright (c) 2018-2025 Jean-Louis Leroy
+// Distributed under the Boost Software License, Version 1.0.
+// See accompanying file LICENSE_1_0.txt
+// or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <boost/openmethod.hpp>
+#include <boost/openmethod/interop/std_shared_ptr.hpp>
+#include <boost/openmethod/interop/std_unique_ptr.hpp>
+#include <boost/openmethod/local_pool_allocator.hpp>
+#include <boost/openmethod/initialize.hpp>
+
+#include <memory_resource>
+#include <string>
+
+#define BOOST_TEST_MODULE allocate_virtual
+#include <boost/test/unit_test.hpp>
+
+#include "test_util.hpp"
+
+using namespace boost::openmethod;
+
+namespace TEST_NS {
+
+using registry = test_registry_<__COUNTER__>::registry_type;
+
+struct Animal {
+    virtual ~Animal() = default;
+};
+
+struct Pet {
+    virtual ~Pet() = default;
+    std::string owner = "Bill";
+};
+
+struct Dog : Animal, Pet {
+    static inline int instances = 0;
+
+    Dog() {
+        ++instances;
+    }
+
+    ~Dog() {
+        --instances;
+    }
+};
+
+struct Cat : Animal {};
+
+BOOST_OPENMETHOD_CLASSES(Animal, Pet, Dog, Cat, registry);
+
+BOOST_OPENMETHOD(
+    name, (virtual_ptr<const Animal, registry>), std::string, registry);
+
+BOOST_OPENMETHOD_OVERRIDE(
+    name, (virtual_ptr<const Dog, registry>), std::string) {
+    return "dog";
+}
+
+BOOST_OPENMETHOD_OVERRIDE(
+    name, (virtual_ptr<const Cat, registry>), std::string) {
+    return "cat";
+}
+
+template<class Class>
+using pool_unique_ptr = std::unique_ptr<
+    Class, allocator_delete<Class, local_pool_allocator<std::byte>>>;
+
+BOOST_OPENMETHOD(
+    adopt,
+    (virtual_ptr<pool_unique_ptr<Animal>, registry>, std::string&), void,
+    registry);
+
+BOOST_OPENMETHOD_OVERRIDE(
+    adopt,
+    (virtual_ptr<pool_unique_ptr<Dog>, registry> dog, std::string& out),
+    void) {
+    out = dog->owner;
+}
+
+BOOST_AUTO_TEST_CASE(allocate_virtual_with_allocator) {
+    initialize<registry>();
+
+    std::size_t count = 0;
+    counting_allocator<char> alloc(&count);
+
+    {
+        shared_virtual_ptr<Animal, registry> cat =
+            allocate_shared_virtual<Cat, registry>(alloc);
+        BOOST_TEST(count == 1u);
+        BOOST_TEST(cat.vptr() == registry::static_vptr<Cat>);
+        BOOST_TEST(name(cat) == "cat");
+
+        auto dog = allocate_unique_virtual<Dog, registry>(alloc);
+        BOOST_TEST(count == 2u);
+        BOOST_TEST(Dog::instances == 1);
+        BOOST_TEST(name(dog) == "dog");
+
+        // Delete via a base that is not at offset 0.
+        virtual_ptr<
+            std::unique_ptr<
+                Pet, allocator_delete<Pet, counting_allocator<char>>>,
+            registry>
+            pet = std::move(dog);
+        BOOST_TEST(pet->owner == "Bill");
+    }
+
+    BOOST_TEST(count == 0u);
+    BOOST_TEST(Dog::instances == 0);
+}
+
+BOOST_AUTO_TEST_CASE(allocate_virtual_with_memory_resource) {
+    initialize<registry>();
+
+    char buffer[1024];
+    std::pmr::monotonic_buffer_resource resource(
+        buffer, sizeof(buffer), std::pmr::null_memory_resource());
+
+    auto cat = allocate_shared_virtual<Cat, registry>(&resource);
+    BOOST_TEST(name(cat) == "cat");
+    auto address = static_cast<const void*>(cat.get());
+    BOOST_TEST(address >= static_cast<const void*>(buffer));
+    BOOST_TEST(address < static_cast<const void*>(buffer + sizeof(buffer)));
+
+    auto dog = allocate_unique_virtual<Dog, registry>(&resource);
+    BOOST_TEST(name(dog) == "dog");
+    address = static_cast<const void*>(dog.get());
+    BOOST_TEST(address >= static_cast<const void*>(buffer));
+    BOOST_TEST(address < static_cast<const void*>(buffer + sizeof(buffer)));
+}
+
+BOOST_AUTO_TEST_CASE(allocate_virtual_with_local_pool) {
+    initialize<registry>();
+
+    local_pool_allocator<std::byte> pool;
+    const void* first;
+
+    {
+        auto dog = allocate_unique_virtual<Dog, registry>(pool);
+        first = dog.get();
+        std::string owner;
+        adopt(std::move(dog), owner);
+        BOOST_TEST(owner == "Bill");
+        BOOST_TEST(Dog::instances == 0);
+    }
+
+    // The block is recycled.
+    auto dog = allocate_unique_virtual<Dog, registry>(pool);
+    BOOST_TEST(static_cast<const void*>(dog.get()) == first);
+
+    auto cat = allocate_shared_virtual<Cat, registry>(pool);
+    BOOST_TEST(name(cat) == "cat");
+}
+
+} // namespace TEST_NS
@@ -0,0 +1,137 @@
+// Copyright (c) 2018-2025 Jean-Louis Leroy
+// Distributed under the Boost Software License, Version 1.0.
+// See accompanying file LICENSE_1_0.txt
+// or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <boost/openmethod.hpp>
+#include <boost/openmethod/interop/std_shared_ptr.hpp>
+#include <boost/openmethod/initialize.hpp>
+
+#include <memory>
+#include <string>
+
+#define BOOST_TEST_MODULE class_intervals
+#include <boost/test/unit_test.hpp>
+
+#include "test_util.hpp"
+
+using namespace boost::openmethod;
+
+namespace {
+
+struct Animal {
+    virtual ~Animal() = default;
+};
+
+struct Pet {
+    virtual ~Pet() = default;
+    std::string owner = "Bill";
+};
+
+struct Dog : Animal, Pet {};
+struct Bulldog : Dog {};
+struct Cat : Animal, Pet {};
+struct Wolf : Animal {};
+
+auto name_dog(const Dog&) -> std::string {
+    return "dog";
+}
+
+auto name_cat(const Cat&) -> std::string {
+    return "cat";
+}
+
+auto name_wolf(const Wolf&) -> std::string {
+    return "wolf";
+}
+
+auto meet_animals(const Animal&, const Animal&) -> std::string {
+    return "ignore";
+}
+
+auto meet_dog_cat(const Dog&, const Cat&) -> std::string {
+    return "chase";
+}
+
+struct name_id;
+struct meet_id;
+
+template<int N>
+using registries = boost::mp11::mp_list<
+    test_registry_<N, policies::class_intervals>,
+    test_registry_<N, policies::class_intervals, policies::indirect_vptr>>;
+
+} // namespace
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(
+    class_intervals, Registry, registries<__COUNTER__>) {
+    using name =
+        method<name_id, std::string(virtual_<const Animal&>), Registry>;
+    using meet = method<
+        meet_id,
+        std::string(virtual_<const Animal&>, virtual_<const Animal&>),
+        Registry>;
+
+    BOOST_OPENMETHOD_REGISTER(
+        use_classes<Animal, Pet, Dog, Bulldog, Cat, Wolf, Registry>);
+    BOOST_OPENMETHOD_REGISTER(
+        typename name::template override<name_dog, name_cat, name_wolf>);
+    BOOST_OPENMETHOD_REGISTER(
+        typename meet::template override<meet_animals, meet_dog_cat>);
+
+    initialize<Registry>();
+
+    Dog dog;
+    Bulldog bulldog;
+    Cat cat;
+    Wolf wolf;
+
+    // Dispatch skips the class headers.
+    BOOST_TEST(name::fn(dog) == "dog");
+    BOOST_TEST(name::fn(bulldog) == "dog");
+    BOOST_TEST(name::fn(cat) == "cat");
+    BOOST_TEST(name::fn(wolf) == "wolf");
+    BOOST_TEST(meet::fn(bulldog, cat) == "chase");
+    BOOST_TEST(meet::fn(cat, dog) == "ignore");
+
+    using animal_ptr = virtual_ptr<Animal, Registry>;
+    using pet_ptr = virtual_ptr<Pet, Registry>;
+
+    // Single inheritance: interval test.
+    BOOST_TEST(is_a<Animal>(animal_ptr(bulldog)));
+    BOOST_TEST(is_a<Dog>(animal_ptr(bulldog)));
+    BOOST_TEST(is_a<Bulldog>(animal_ptr(bulldog)));
+    BOOST_TEST(is_a<Dog>(animal_ptr(dog)));
+    BOOST_TEST(!is_a<Bulldog>(animal_ptr(dog)));
+    BOOST_TEST(!is_a<Dog>(animal_ptr(cat)));
+    BOOST_TEST(!is_a<Cat>(animal_ptr(wolf)));
+    BOOST_TEST(!is_a<Wolf>(animal_ptr(bulldog)));
+
+    // Multiple inheritance: the subclasses of Pet are numbered under Animal.
+    BOOST_TEST(is_a<Pet>(animal_ptr(dog)));
+    BOOST_TEST(is_a<Pet>(animal_ptr(bulldog)));
+    BOOST_TEST(is_a<Pet>(animal_ptr(cat)));
+    BOOST_TEST(!is_a<Pet>(animal_ptr(wolf)));
+    BOOST_TEST(is_a<Animal>(pet_ptr(cat)));
+    BOOST_TEST(is_a<Bulldog>(pet_ptr(bulldog)));
+    BOOST_TEST(!is_a<Dog>(pet_ptr(cat)));
+
+    auto dog_ptr = fast_cast<Dog>(animal_ptr(bulldog));
+    BOOST_TEST(dog_ptr.get() == &bulldog);
+    BOOST_TEST(dog_ptr.vptr() == Registry::template static_vptr<Bulldog>);
+    BOOST_TEST(fast_cast<Cat>(animal_ptr(wolf)).get() == nullptr);
+    BOOST_TEST(fast_cast<Cat>(animal_ptr(nullptr)).get() == nullptr);
+
+    auto cat_ptr = fast_cast<Cat>(pet_ptr(cat));
+    BOOST_TEST(cat_ptr.get() == &cat);
+
+    auto shared = make_shared_virtual<Bulldog, Registry>();
+    auto shared_dog = fast_cast<Dog>(
+        virtual_ptr<std::shared_ptr<Animal>, Registry>(shared));
+    BOOST_TEST(shared_dog.get() == shared.get());
+    BOOST_TEST(
+        fast_cast<Wolf>(virtual_ptr<std::shared_ptr<Animal>, Registry>(shared))
+            .get() == nullptr);
+
+    finalize<Registry>();
+}
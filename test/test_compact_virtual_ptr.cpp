@@ -0,0 +1,104 @@
+// Copyright (c) 2018-2025 Jean-Louis Leroy
+// Distributed under the Boost Software License, Version 1.0.
+// See accompanying file LICENSE_1_0.txt
+// or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <boost/openmethod.hpp>
+#include <boost/openmethod/compact_virtual_ptr.hpp>
+#include <boost/openmethod/initialize.hpp>
+
+#include <string>
+#include <vector>
+
+#define BOOST_TEST_MODULE compact_virtual_ptr
+#include <boost/test/unit_test.hpp>
+
+#include "test_util.hpp"
+
+using namespace boost::openmethod;
+
+namespace TEST_NS {
+
+using registry =
+    test_registry_<__COUNTER__, policies::class_intervals>::registry_type;
+
+struct Animal {
+    virtual ~Animal() = default;
+};
+
+struct Pet {
+    virtual ~Pet() = default;
+    std::string owner = "Bill";
+};
+
+struct Dog : Animal, Pet {};
+struct Cat : Animal, Pet {};
+
+BOOST_OPENMETHOD_CLASSES(Animal, Pet, Dog, Cat, registry);
+
+BOOST_OPENMETHOD(
+    name, (virtual_ptr<const Animal, registry>), std::string, registry);
+
+BOOST_OPENMETHOD_OVERRIDE(
+    name, (virtual_ptr<const Dog, registry>), std::string) {
+    return "dog";
+}
+
+BOOST_OPENMETHOD_OVERRIDE(
+    name, (virtual_ptr<const Cat, registry>), std::string) {
+    return "cat";
+}
+
+BOOST_OPENMETHOD(
+    owner, (virtual_ptr<const Pet, registry>), std::string, registry);
+
+BOOST_OPENMETHOD_OVERRIDE(
+    owner, (virtual_ptr<const Pet, registry> pet), std::string) {
+    return pet->owner;
+}
+
+static_assert(
+    sizeof(compact_virtual_ptr<Animal, registry>) == sizeof(Animal*));
+
+BOOST_AUTO_TEST_CASE(compact_virtual_ptr_dispatch) {
+    initialize<registry>();
+
+    Dog dog;
+    Cat cat;
+    dog.owner = "Snoopy's owner";
+
+    compact_virtual_ptr<Animal, registry> animal = dog;
+    BOOST_TEST(animal.get() == &dog);
+    BOOST_TEST(animal.vptr() == registry::static_vptr<Dog>);
+    BOOST_TEST(name(animal) == "dog");
+
+    // Conversions adjust the address, and keep the class.
+    compact_virtual_ptr<Pet, registry> pet = compact_virtual_ptr<Dog, registry>(
+        final_virtual_ptr<registry>(dog));
+    BOOST_TEST(pet.get() == static_cast<Pet*>(&dog));
+    BOOST_TEST(pet.vptr() == registry::static_vptr<Dog>);
+    BOOST_TEST(owner(pet) == "Snoopy's owner");
+
+    auto final_cat = compact_virtual_ptr<const Animal, registry>::final(cat);
+    BOOST_TEST(name(final_cat) == "cat");
+
+    std::vector<compact_virtual_ptr<const Animal, registry>> animals{
+        virtual_ptr<Dog, registry>(dog), final_cat};
+    BOOST_TEST(name(animals[0]) == "dog");
+    BOOST_TEST(name(animals[1]) == "cat");
+    BOOST_TEST((animals[1] == final_cat));
+    BOOST_TEST((animals[0] != final_cat));
+
+    compact_virtual_ptr<Animal, registry> null{nullptr};
+    BOOST_TEST(null.get() == nullptr);
+    virtual_ptr<Animal, registry> wide = null;
+    BOOST_TEST(wide.get() == nullptr);
+
+    // The pointers survive a new initialization, which may move the v-tables.
+    initialize<registry>();
+    BOOST_TEST(animal.vptr() == registry::static_vptr<Dog>);
+    BOOST_TEST(name(animal) == "dog");
+    BOOST_TEST(owner(pet) == "Snoopy's owner");
+}
+
+} // namespace TEST_NS
@@ -4,6 +4,7 @@
 // or copy at http://www.boost.org/LICENSE_1_0.txt)
 
 #include <iostream>
+#include <set>
 #include <type_traits>
 
 #include <boost/openmethod.hpp>
@@ -27,8 +28,8 @@ auto operator<<(std::ostream& os, const class_* cls) -> std::ostream& {
 
 std::string empty = "{}";
 
-template<template<typename...> class Container, typename T>
-auto str(const Container<T>& container) {
+template<template<typename...> class Container, typename T, typename... More>
+auto str(const Container<T, More...>& container) {
     std::ostringstream os;
     os << "{";
     const char* sep = "";
@@ -51,8 +52,16 @@ auto sstr(Ts... args) {
     return str(vec);
 }
 
-template<typename T>
-auto sstr(const std::unordered_set<T>& container) {
+template<typename T, class Allocator>
+auto sstr(const std::vector<T, Allocator>& container) {
+    std::vector<T> vec(container.begin(), container.end());
+    std::sort(vec.begin(), vec.end());
+
+    return str(vec);
+}
+
+template<typename T, typename... More>
+auto sstr(const std::unordered_set<T, More...>& container) {
     return sstr(std::vector<T>(container.begin(), container.end()));
 }
 
@@ -112,7 +121,7 @@ BOOST_AUTO_TEST_CASE(test_use_classes_linear) {
     BOOST_OPENMETHOD_CLASSES(D3, D4, registry);
     BOOST_OPENMETHOD_CLASSES(D4, D5, D3, registry);
 
-    auto comp = initialize<registry>();
+    auto comp = initialize<registry>(retain_compiler());
 
     auto base = get_class<Base>(comp);
     auto d1 = get_class<D1>(comp);
@@ -149,7 +158,7 @@ BOOST_AUTO_TEST_CASE(test_use_classes_diamond) {
 
     std::vector<class_*> actual, expected;
 
-    auto comp = initialize<test_registry>();
+    auto comp = initialize<test_registry>(retain_compiler());
 
     auto a = get_class<A>(comp);
     auto b = get_class<B>(comp);
@@ -240,7 +249,7 @@ BOOST_AUTO_TEST_CASE(test_assign_slots_a_b1_c) {
     BOOST_OPENMETHOD_REGISTER(use_classes<A, C, test_registry>);
     ADD_METHOD(B);
 
-    auto comp = initialize<test_registry>();
+    auto comp = initialize<test_registry>(retain_compiler());
 
     BOOST_TEST_REQUIRE(check(comp[m_B])->slots.size() == 1u);
     BOOST_TEST(check(comp[m_B])->slots[0] == 0u);
@@ -270,7 +279,7 @@ BOOST_AUTO_TEST_CASE(test_assign_slots_a1_b1_c1) {
     ADD_METHOD(A);
     ADD_METHOD(B);
     ADD_METHOD(C);
-    auto comp = initialize<test_registry>();
+    auto comp = initialize<test_registry>(retain_compiler());
 
     BOOST_TEST_REQUIRE(check(comp[m_A])->slots.size() == 1u);
     BOOST_TEST(check(comp[m_A])->slots[0] == 0u);
@@ -311,7 +320,8 @@ BOOST_AUTO_TEST_CASE(test_assign_slots_a1_b1_d1_c1_d1) {
     ADD_METHOD(B);
     ADD_METHOD(C);
     ADD_METHOD(D);
-    auto comp = initialize<test_registry>();
+    auto comp = initialize<test_registry>(
+        retain_compiler(), slot_budget(std::chrono::microseconds(0)));
 
     BOOST_TEST_REQUIRE(check(comp[m_A])->slots.size() == 1u);
     BOOST_TEST(check(comp[m_A])->slots[0] == 0u);
@@ -362,7 +372,8 @@ BOOST_AUTO_TEST_CASE(test_assign_slots_a1_b1_d1_c1_d1_e2) {
     ADD_METHOD_N(E, 1);
     ADD_METHOD_N(E, 2);
     ADD_METHOD_N(E, 3);
-    auto comp = initialize<test_registry>();
+    auto comp = initialize<test_registry>(
+        retain_compiler(), slot_budget(std::chrono::microseconds(0)));
 
     BOOST_TEST_REQUIRE(check(comp[m_A])->slots.size() == 1u);
     BOOST_TEST(check(comp[m_A])->slots[0] == 0u);
@@ -393,6 +404,65 @@ BOOST_AUTO_TEST_CASE(test_assign_slots_a1_b1_d1_c1_d1_e2) {
     BOOST_TEST(get_class<E>(comp)->vtbl.size() == 5u);
 }
 
+BOOST_AUTO_TEST_CASE(test_optimize_slots_a1_b1_d1_c1_d1) {
+    using test_registry = test_registry_<__COUNTER__>;
+
+    /*
+      A1
+     / \
+    B1  C1 - greedy: 4 slots in C, optimized: 2
+     \ /
+      D1
+    */
+
+    struct A {
+        virtual ~A() = default;
+    };
+    struct B : virtual A {};
+    struct C : virtual A {};
+    struct D : B, C {};
+
+    BOOST_OPENMETHOD_REGISTER(use_classes<A, test_registry>);
+    BOOST_OPENMETHOD_REGISTER(use_classes<A, B, test_registry>);
+    BOOST_OPENMETHOD_REGISTER(use_classes<A, C, test_registry>);
+    BOOST_OPENMETHOD_REGISTER(use_classes<D, B, C, test_registry>);
+    ADD_METHOD(A);
+    ADD_METHOD(B);
+    ADD_METHOD(C);
+    ADD_METHOD(D);
+    auto comp = initialize<test_registry>(retain_compiler());
+
+    BOOST_TEST(comp.report.greedy_vtbl_words == 11u);
+    BOOST_TEST(comp.report.vtbl_words == 9u);
+
+    BOOST_TEST(get_class<A>(comp)->vtbl.size() == 1u);
+    BOOST_TEST(get_class<B>(comp)->vtbl.size() == 2u);
+    BOOST_TEST(get_class<C>(comp)->vtbl.size() == 2u);
+    BOOST_TEST(get_class<D>(comp)->vtbl.size() == 4u);
+
+    std::set<std::size_t> slots;
+
+    for (auto m : {comp[m_A], comp[m_B], comp[m_C], comp[m_D]}) {
+        auto slot = check(m)->slots[0];
+        BOOST_TEST(slot >= get_class<D>(comp)->first_slot);
+        BOOST_TEST(slot < get_class<D>(comp)->first_slot + 4);
+        slots.insert(slot);
+    }
+
+    BOOST_TEST(slots.size() == 4u);
+
+    for (auto cls : {get_class<A>(comp), get_class<B>(comp),
+                     get_class<C>(comp)}) {
+        auto slot = check(comp[m_A])->slots[0];
+        BOOST_TEST(slot >= cls->first_slot);
+        BOOST_TEST(slot < cls->first_slot + cls->vtbl.size());
+    }
+
+    auto result = initialize<test_registry>(
+        slot_budget(std::chrono::microseconds(0)));
+    BOOST_TEST(result.report.vtbl_words == 11u);
+}
+
 BOOST_AUTO_TEST_CASE(test_assign_slots_a1_c1_b1) {
     using test_registry = test_registry_<__COUNTER__>;
 
@@ -416,7 +486,7 @@ BOOST_AUTO_TEST_CASE(test_assign_slots_a1_c1_b1) {
     ADD_METHOD(A);
     ADD_METHOD(B);
     ADD_METHOD(C);
-    auto comp = initialize<test_registry>();
+    auto comp = initialize<test_registry>(retain_compiler());
 
     BOOST_TEST_REQUIRE(check(comp[m_A])->slots.size() == 1u);
     BOOST_TEST(check(comp[m_A])->slots[0] == 0u);
@@ -431,3 +501,167 @@ BOOST_AUTO_TEST_CASE(test_assign_slots_a1_c1_b1) {
     BOOST_TEST(get_class<B>(comp)->first_slot == 2u);
     BOOST_TEST(get_class<B>(comp)->vtbl.size() == 1u);
 }
+
+namespace shared_vtbls {
+
+/*
+        Animal
+      /   |   \
+    Dog  Cat  Cow - only Cow overrides kind: Animal, Dog and Cat share a
+                    v-table
+*/
+
+struct Animal {
+    virtual ~Animal() = default;
+};
+struct Dog : Animal {};
+struct Cat : Animal {};
+struct Cow : Animal {};
+
+auto kind_animal(Animal&) -> int {
+    return 1;
+}
+
+auto kind_cow(Cow&) -> int {
+    return 2;
+}
+
+} // namespace shared_vtbls
+
+BOOST_AUTO_TEST_CASE(test_shared_vtbls) {
+    using namespace shared_vtbls;
+    using test_registry = test_registry_<__COUNTER__>;
+    using kind = method<Animal, auto(virtual_<Animal&>)->int, test_registry>;
+
+    BOOST_OPENMETHOD_REGISTER(
+        use_classes<Animal, Dog, Cat, Cow, test_registry>);
+    BOOST_OPENMETHOD_REGISTER(kind::override<kind_animal, kind_cow>);
+
+    auto comp = initialize<test_registry>(retain_compiler());
+
+    // One of Animal, Dog and Cat owns the shared v-table.
+    auto owners = 0;
+
+    for (auto cls : {get_class<Animal>(comp), get_class<Dog>(comp),
+                     get_class<Cat>(comp)}) {
+        owners += cls->vtbl_owner == nullptr;
+    }
+
+    BOOST_TEST(owners == 1);
+    BOOST_TEST(get_class<Cow>(comp)->vtbl_owner == nullptr);
+
+    auto animal_vptr = test_registry::static_vptr<Animal>;
+    BOOST_TEST(test_registry::static_vptr<Dog> == animal_vptr);
+    BOOST_TEST(test_registry::static_vptr<Cat> == animal_vptr);
+    BOOST_TEST(test_registry::static_vptr<Cow> != animal_vptr);
+
+    Dog dog;
+    Cat cat;
+    Cow cow;
+    BOOST_TEST(kind::fn(dog) == 1);
+    BOOST_TEST(kind::fn(cat) == 1);
+    BOOST_TEST(kind::fn(cow) == 2);
+}
+
+namespace merged_slices {
+
+/*
+              Animal
+         /      |      \
+       Pet    Wild    Farm   (virtual bases)
+         \      /      /
+         PetWild      /
+              \      /
+           PetWildFarm
+
+meet(Animal, PetWild) and meet(Animal, PetWildFarm) are both ambiguous: the
+two groups select identical slices of the dispatch table.
+*/
+
+struct Animal {
+    virtual ~Animal() = default;
+};
+struct Pet : virtual Animal {};
+struct Wild : virtual Animal {};
+struct Farm : virtual Animal {};
+struct PetWild : Pet, Wild {};
+struct PetWildFarm : PetWild, Farm {};
+
+auto meet_pet(Animal&, Pet&) -> int {
+    return 1;
+}
+
+auto meet_wild(Animal&, Wild&) -> int {
+    return 2;
+}
+
+auto meet_farm(Animal&, Farm&) -> int {
+    return 3;
+}
+
+} // namespace merged_slices
+
+BOOST_AUTO_TEST_CASE(test_merged_slices) {
+    using namespace merged_slices;
+    using test_registry = test_registry_<__COUNTER__>;
+    using meet = method<
+        Animal, auto(virtual_<Animal&>, virtual_<Animal&>)->int,
+        test_registry>;
+
+    BOOST_OPENMETHOD_REGISTER(use_classes<
+                              Animal, Pet, Wild, Farm, PetWild, PetWildFarm,
+                              test_registry>);
+    BOOST_OPENMETHOD_REGISTER(
+        meet::override<meet_pet, meet_wild, meet_farm>);
+
+    auto comp = initialize<test_registry>(retain_compiler());
+    auto m = check(comp[meet::fn]);
+
+    // 1 x 6 groups, two of which are merged.
+    BOOST_TEST(m->dispatch_table.size() == 5u);
+    BOOST_TEST(m->report.cells == 5u);
+    BOOST_TEST(m->report.saved_bytes == sizeof(detail::word));
+    BOOST_TEST(comp.report.saved_bytes == sizeof(detail::word));
+
+    auto group = [&](auto cls) {
+        return cls->vtbl[m->slots[1] - cls->first_slot].group_index;
+    };
+
+    BOOST_TEST(
+        group(get_class<PetWild>(comp)) == group(get_class<PetWildFarm>(comp)));
+    BOOST_TEST(group(get_class<Pet>(comp)) != group(get_class<Wild>(comp)));
+
+    Animal animal;
+    Pet pet;
+    Wild wild;
+    Farm farm;
+    PetWildFarm pwf;
+    BOOST_TEST(meet::fn(animal, pet) == 1);
+    BOOST_TEST(meet::fn(pwf, wild) == 2);
+    BOOST_TEST(meet::fn(pet, farm) == 3);
+}
+
+BOOST_AUTO_TEST_CASE(test_initialize_returns_report) {
+    using test_registry = test_registry_<__COUNTER__>;
+
+    struct A {
+        virtual ~A() = default;
+    };
+    struct B : A {};
+
+    BOOST_OPENMETHOD_REGISTER(use_classes<A, B, test_registry>);
+    ADD_METHOD(B);
+
+    auto result = initialize<test_registry>();
+    using compiler = test_registry::compiler<>;
+    static_assert(std::is_same_v<
+                  decltype(result),
+                  initialize_result<compiler::report_type>>);
+    BOOST_TEST(result.report.not_implemented == 1u);
+
+    auto comp = initialize<test_registry>(retain_compiler());
+    static_assert(std::is_same_v<
+                  decltype(comp), test_registry::compiler<retain_compiler>>);
+    BOOST_TEST(comp.report.not_implemented == 1u);
+    BOOST_TEST(check(comp[m_B])->slots.size() == 1u);
+}
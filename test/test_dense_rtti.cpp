@@ -0,0 +1,121 @@
+// Copyright (c) 2018-2025 Jean-Louis Leroy
+// Distributed under the Boost Software License, Version 1.0.
+// See accompanying file LICENSE_1_0.txt
+// or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <boost/openmethod.hpp>
+#include <boost/openmethod/policies/dense_rtti.hpp>
+#include <boost/openmethod/policies/throw_error_handler.hpp>
+#include <boost/openmethod/initialize.hpp>
+
+#include <set>
+#include <string>
+
+#define BOOST_TEST_MODULE dense_rtti
+#include <boost/test/unit_test.hpp>
+
+#include "test_util.hpp"
+
+using namespace boost::openmethod;
+
+namespace TEST_NS {
+
+using registry = test_registry_<
+    __COUNTER__, policies::dense_rtti<>, policies::runtime_checks,
+    policies::throw_error_handler>::without<policies::type_hash>;
+
+static_assert(registry::has_deferred_static_rtti);
+
+struct Animal : dense_type_id_base<Animal, registry> {
+    virtual ~Animal() = default;
+};
+
+struct Dog : Animal, dense_type_id_derived<Dog, Animal> {};
+struct Cat : Animal, dense_type_id_derived<Cat, Animal> {};
+struct Unregistered : Animal, dense_type_id_derived<Unregistered, Animal> {};
+
+BOOST_OPENMETHOD_CLASSES(Animal, Dog, Cat, registry);
+
+BOOST_OPENMETHOD(name, (virtual_<const Animal&>), std::string, registry);
+
+BOOST_OPENMETHOD_OVERRIDE(name, (const Dog&), std::string) {
+    return "dog";
+}
+
+BOOST_OPENMETHOD_OVERRIDE(name, (const Cat&), std::string) {
+    return "cat";
+}
+
+// A hierarchy that stores its dense type id in the objects, without the mixins.
+struct Shape {
+    Shape() : type(registry::rtti::static_type<Shape>()) {
+    }
+
+    virtual ~Shape() = default;
+
+    type_id type;
+};
+
+struct Circle : Shape {
+    Circle() {
+        type = registry::rtti::static_type<Circle>();
+    }
+};
+
+struct Square : virtual Shape {
+    Square() {
+        type = registry::rtti::static_type<Square>();
+    }
+};
+
+auto boost_openmethod_type_id(const Shape& shape, registry*) -> type_id {
+    return shape.type;
+}
+
+BOOST_OPENMETHOD_CLASSES(Shape, Circle, Square, registry);
+
+BOOST_OPENMETHOD(sides, (virtual_<const Shape&>), int, registry);
+
+BOOST_OPENMETHOD_OVERRIDE(sides, (const Circle&), int) {
+    return 0;
+}
+
+BOOST_OPENMETHOD_OVERRIDE(sides, (const Square&), int) {
+    return 4;
+}
+
+BOOST_AUTO_TEST_CASE(dense_type_ids) {
+    initialize<registry>();
+
+    std::set<std::size_t> ids{
+        std::size_t(registry::rtti::static_type<Animal>()),
+        std::size_t(registry::rtti::static_type<Dog>()),
+        std::size_t(registry::rtti::static_type<Cat>()),
+        std::size_t(registry::rtti::static_type<Shape>()),
+        std::size_t(registry::rtti::static_type<Circle>()),
+        std::size_t(registry::rtti::static_type<Square>())};
+
+    // Only the registered classes are numbered.
+    BOOST_TEST(ids.size() == 6u);
+    BOOST_TEST(*ids.begin() == 1u);
+    BOOST_TEST(*ids.rbegin() == 6u);
+
+    BOOST_TEST(
+        registry::rtti::dynamic_type(Dog()) ==
+        registry::rtti::static_type<Dog>());
+
+    BOOST_TEST(name(Dog()) == "dog");
+    BOOST_TEST(name(Cat()) == "cat");
+    BOOST_TEST(sides(Circle()) == 0);
+    BOOST_TEST(sides(Square()) == 4);
+
+    BOOST_CHECK_THROW(name(Unregistered()), missing_class);
+
+    // Ids are stable across initializations.
+    auto dog_id = registry::rtti::static_type<Dog>();
+    initialize<registry>();
+    BOOST_TEST(registry::rtti::static_type<Dog>() == dog_id);
+    BOOST_TEST(name(Dog()) == "dog");
+}
+
+} // namespace TEST_NS
@@ -240,6 +240,68 @@ BOOST_AUTO_TEST_CASE(cast_args_shared_ptr_by_ref) {
 
 namespace TEST_NS {
 
+// -----------------------------------------------------------------------------
+// pass virtual args by borrowed_shared_ptr
+
+using test_registry = test_registry_<__COUNTER__>;
+using namespace animals;
+
+BOOST_OPENMETHOD_CLASSES(Animal, Dog, Cat, test_registry);
+
+BOOST_OPENMETHOD(
+    name, (virtual_<borrowed_shared_ptr<const Animal>>), std::string,
+    test_registry);
+
+long use_count;
+
+BOOST_OPENMETHOD_OVERRIDE(
+    name, (borrowed_shared_ptr<const Cat> cat), std::string) {
+    use_count = cat.share().use_count() - 1;
+    return cat->owner + "'s cat " + cat->name;
+}
+
+BOOST_OPENMETHOD_OVERRIDE(
+    name, (borrowed_shared_ptr<const Dog> dog), std::string) {
+    use_count = dog.share().use_count() - 1;
+    return dog->owner + "'s dog " + dog->name;
+}
+
+// Overriders cannot retain the view by accident.
+static_assert(!std::is_copy_constructible_v<borrowed_shared_ptr<const Cat>>);
+static_assert(!std::is_move_constructible_v<borrowed_shared_ptr<const Cat>>);
+static_assert(!std::is_copy_assignable_v<borrowed_shared_ptr<const Cat>>);
+static_assert(!std::is_constructible_v<
+              borrowed_shared_ptr<const Animal>,
+              borrowed_shared_ptr<const Cat>&>);
+static_assert(std::is_constructible_v<
+              borrowed_shared_ptr<const Animal>,
+              borrowed_shared_ptr<const Cat>&&>);
+
+BOOST_AUTO_TEST_CASE(cast_args_borrowed_shared_ptr) {
+    initialize<test_registry>();
+
+    auto spot = std::make_shared<Dog>("Spot");
+    BOOST_TEST(name(spot) == "Bill's dog Spot");
+    BOOST_TEST(use_count == 1);
+
+    std::shared_ptr<Animal> felix = std::make_shared<Cat>("Felix");
+    BOOST_TEST(name(felix) == "Bill's cat Felix");
+    BOOST_TEST(use_count == 1);
+
+    borrowed_shared_ptr<const Animal> borrowed = felix;
+    auto shared = virtual_traits<
+        borrowed_shared_ptr<const Animal>,
+        test_registry>::cast<borrowed_shared_ptr<const Cat>>(borrowed)
+                      .share();
+    BOOST_TEST(felix.use_count() == 2);
+    felix.reset();
+    BOOST_TEST(shared->name == "Felix");
+}
+
+} // namespace TEST_NS
+
+namespace TEST_NS {
+
 // -----------------------------------------------------------------------------
 // pass virtual args by unique_ptr
 
@@ -448,3 +510,516 @@ BOOST_AUTO_TEST_CASE(comma_in_return_type) {
 }
 
 } // namespace test_comma_in_return_type
+
+namespace test_monomorphic {
+
+// Monomorphic methods bypass dispatch only without runtime checks.
+using test_registry = test_registry_<__COUNTER__, counting_rtti<>>::without<
+    policies::runtime_checks>;
+using rtti = test_registry::rtti;
+
+struct Animal {
+    virtual ~Animal() = default;
+};
+
+struct Dog : Animal {};
+struct Cat : Animal {};
+
+BOOST_OPENMETHOD_CLASSES(Animal, Dog, Cat, test_registry);
+
+BOOST_OPENMETHOD(legs, (virtual_<const Animal&>), int, test_registry);
+
+BOOST_OPENMETHOD_OVERRIDE(legs, (const Animal&), int) {
+    return 4;
+}
+
+BOOST_OPENMETHOD(
+    meet, (virtual_<const Animal&>, virtual_<const Animal&>), int,
+    test_registry);
+
+BOOST_OPENMETHOD_OVERRIDE(meet, (const Animal&, const Animal&), int) {
+    return 0;
+}
+
+BOOST_OPENMETHOD(sound, (virtual_<const Animal&>), int, test_registry);
+
+BOOST_OPENMETHOD_OVERRIDE(sound, (const Dog&), int) {
+    return 1;
+}
+
+BOOST_AUTO_TEST_CASE(monomorphic_methods_bypass_dispatch) {
+    initialize<test_registry>();
+
+    Dog dog;
+    Cat cat;
+
+    auto calls = rtti::calls;
+    BOOST_TEST(legs(dog) == 4);
+    BOOST_TEST(legs(cat) == 4);
+    BOOST_TEST(meet(dog, cat) == 0);
+    BOOST_TEST(rtti::calls == calls);
+
+    // Cat has no overrider: sound must dispatch.
+    BOOST_TEST(sound(dog) == 1);
+    BOOST_TEST(rtti::calls == calls + 1);
+
+    finalize<test_registry>();
+    initialize<test_registry>();
+    BOOST_TEST(legs(dog) == 4);
+    BOOST_TEST(rtti::calls == calls + 1);
+}
+
+} // namespace test_monomorphic
+
+namespace test_call_static {
+
+using test_registry =
+    test_registry_<__COUNTER__, counting_rtti<>>::without<
+        policies::runtime_checks>;
+using checked_registry =
+    test_registry_<__COUNTER__, policies::runtime_checks>;
+using rtti = test_registry::rtti;
+
+struct Animal {
+    virtual ~Animal() = default;
+};
+
+struct Dog final : Animal {};
+struct Cat final : Animal {};
+struct Cow : Animal {};
+
+BOOST_OPENMETHOD_REGISTER(use_classes<Animal, Dog, Cat, Cow, test_registry>);
+BOOST_OPENMETHOD_REGISTER(
+    use_classes<Animal, Dog, Cat, Cow, checked_registry>);
+
+auto meet_animals(const Animal&, const Animal&) -> std::string {
+    return "ignore";
+}
+
+auto meet_dog_cat(const Dog&, const Cat&) -> std::string {
+    return "chase";
+}
+
+auto meet_cat_animal(const Cat&, const Animal&) -> std::string {
+    return "hiss";
+}
+
+struct meet_id;
+
+template<class Registry>
+using meet = method<
+    meet_id,
+    auto(virtual_<const Animal&>, virtual_<const Animal&>)->std::string,
+    Registry>;
+
+BOOST_OPENMETHOD_REGISTER(
+    meet<test_registry>::override<
+        meet_animals, meet_dog_cat, meet_cat_animal>);
+BOOST_OPENMETHOD_REGISTER(
+    meet<checked_registry>::override<
+        meet_animals, meet_dog_cat, meet_cat_animal>);
+
+BOOST_AUTO_TEST_CASE(call_static_selects_overrider_at_compile_time) {
+    initialize<test_registry>();
+
+    Dog dog;
+    Cat cat;
+    Cow cow;
+    auto& fn = meet<test_registry>::fn;
+
+    auto calls = rtti::calls;
+    BOOST_TEST(
+        (fn.call_static_unchecked<
+            meet_animals, meet_dog_cat, meet_cat_animal>(dog, cat)) ==
+        "chase");
+    BOOST_TEST(
+        (fn.call_static_unchecked<
+            meet_animals, meet_dog_cat, meet_cat_animal>(cat, dog)) ==
+        "hiss");
+    BOOST_TEST(
+        (fn.call_static_unchecked<
+            meet_animals, meet_dog_cat, meet_cat_animal>(dog, dog)) ==
+        "ignore");
+    BOOST_TEST(rtti::calls == calls);
+
+    // The selection is checked against the dispatch tables.
+    BOOST_TEST(
+        (fn.call_static<meet_animals, meet_dog_cat, meet_cat_animal>(
+            dog, cat)) == "chase");
+    BOOST_TEST(rtti::calls == calls + 2);
+    calls = rtti::calls;
+
+    // Cow is not final: dispatch.
+    BOOST_TEST(
+        (fn.call_static<meet_animals, meet_dog_cat, meet_cat_animal>(
+            cat, cow)) == "hiss");
+    BOOST_TEST(rtti::calls == calls + 2);
+
+    // No applicable overrider among Fn...: dispatch.
+    BOOST_TEST((fn.call_static<meet_dog_cat>(cat, dog)) == "hiss");
+    BOOST_TEST(rtti::calls == calls + 4);
+}
+
+BOOST_AUTO_TEST_CASE(call_static_checks_selection) {
+    initialize<test_registry>();
+    initialize<checked_registry>();
+
+    Dog dog;
+    Cat cat;
+
+    // meet_dog_cat is missing from the list: call_static finds it in the
+    // dispatch table, even without runtime_checks; call_static_unchecked
+    // does not.
+    BOOST_TEST(
+        (meet<test_registry>::fn.call_static<meet_animals>(dog, cat)) ==
+        "chase");
+    BOOST_TEST(
+        (meet<test_registry>::fn.call_static_unchecked<meet_animals>(
+            dog, cat)) == "ignore");
+
+    // meet_dog_cat is missing from the list, the dispatch table wins.
+    BOOST_TEST(
+        (meet<checked_registry>::fn.call_static<meet_animals>(dog, cat)) ==
+        "chase");
+    BOOST_TEST(
+        (meet<checked_registry>::fn.call_static<meet_animals>(dog, dog)) ==
+        "ignore");
+}
+
+} // namespace test_call_static
+
+namespace test_call_direct {
+
+using test_registry = test_registry_<__COUNTER__>;
+
+struct Animal {
+    virtual ~Animal() = default;
+};
+
+struct Dog : Animal {};
+struct Cat : Animal {};
+
+BOOST_OPENMETHOD_REGISTER(use_classes<Animal, Dog, Cat, test_registry>);
+
+auto meet_animals(const Animal&, const Animal&, std::string name)
+    -> std::string {
+    return "ignore " + name;
+}
+
+auto meet_dog_cat(const Dog&, const Cat&, std::string name) -> std::string {
+    return "chase " + name;
+}
+
+auto meet_cat_dog(const Cat&, const Dog&, std::string name) -> std::string {
+    return "hiss " + name;
+}
+
+struct meet_id;
+
+using meet = method<
+    meet_id,
+    auto(virtual_<const Animal&>, virtual_<const Animal&>, std::string)
+        ->std::string,
+    test_registry>;
+
+BOOST_OPENMETHOD_REGISTER(
+    meet::override<meet_animals, meet_dog_cat, meet_cat_dog>);
+
+BOOST_AUTO_TEST_CASE(call_direct_matches_known_overriders) {
+    initialize<test_registry>();
+
+    Dog dog;
+    Cat cat;
+
+    BOOST_TEST(
+        (meet::fn.call_direct<meet_dog_cat, meet_animals>(dog, cat, "Tom")) ==
+        "chase Tom");
+    BOOST_TEST(
+        (meet::fn.call_direct<meet_dog_cat, meet_animals>(dog, dog, "Rex")) ==
+        "ignore Rex");
+
+    // meet_cat_dog is not listed: called indirectly.
+    BOOST_TEST(
+        (meet::fn.call_direct<meet_dog_cat, meet_animals>(cat, dog, "Rex")) ==
+        "hiss Rex");
+    BOOST_TEST((meet::fn.call_direct<>(cat, dog, "Rex")) == "hiss Rex");
+}
+
+} // namespace test_call_direct
+
+namespace test_argument_moves {
+
+using test_registry = test_registry_<__COUNTER__>;
+
+template<int>
+struct counted {
+    static inline int copies = 0;
+    static inline int moves = 0;
+
+    counted() = default;
+
+    counted(const counted&) {
+        ++copies;
+    }
+
+    counted(counted&&) noexcept {
+        ++moves;
+    }
+
+    static auto count() -> std::pair<int, int> {
+        auto result = std::pair(copies, moves);
+        copies = moves = 0;
+
+        return result;
+    }
+};
+
+struct Animal {
+    virtual ~Animal() = default;
+};
+
+struct Dog : Animal {};
+
+BOOST_OPENMETHOD_REGISTER(use_classes<Animal, Dog, test_registry>);
+
+struct take_id;
+
+using take = method<
+    take_id,
+    auto(virtual_<const Animal&>, counted<0>, const counted<1>&, counted<2>&&)
+        ->int,
+    test_registry>;
+
+auto take_animal(const Animal&, counted<0>, const counted<1>&, counted<2>&&)
+    -> int {
+    return 1;
+}
+
+auto take_dog(
+    const Dog& dog, counted<0> c0, const counted<1>& c1, counted<2>&& c2)
+    -> int {
+    return take::next<take_dog>(dog, std::move(c0), c1, std::move(c2)) + 1;
+}
+
+BOOST_OPENMETHOD_REGISTER(take::override<take_animal, take_dog>);
+
+BOOST_AUTO_TEST_CASE(by_value_arguments_are_moved_once) {
+    initialize<test_registry>();
+
+    Animal animal;
+    counted<0> c0;
+    counted<1> c1;
+    counted<2> c2;
+
+    BOOST_TEST(take::fn(animal, counted<0>(), c1, std::move(c2)) == 1);
+    BOOST_TEST((counted<0>::count() == std::pair(0, 1)));
+    BOOST_TEST((counted<1>::count() == std::pair(0, 0)));
+    BOOST_TEST((counted<2>::count() == std::pair(0, 0)));
+
+    BOOST_TEST(take::fn(animal, c0, c1, std::move(c2)) == 1);
+    BOOST_TEST((counted<0>::count() == std::pair(1, 1)));
+    BOOST_TEST((counted<1>::count() == std::pair(0, 0)));
+    BOOST_TEST((counted<2>::count() == std::pair(0, 0)));
+
+    BOOST_TEST(
+        take::fn.call_direct<take_animal>(
+            animal, std::move(c0), c1, counted<2>()) == 1);
+    BOOST_TEST((counted<0>::count() == std::pair(0, 2)));
+    BOOST_TEST((counted<1>::count() == std::pair(0, 0)));
+    BOOST_TEST((counted<2>::count() == std::pair(0, 0)));
+
+    // `next` keeps the method's signature.
+    Dog dog;
+    BOOST_TEST(take::fn(dog, counted<0>(), c1, std::move(c2)) == 2);
+    BOOST_TEST((counted<0>::count() == std::pair(0, 3)));
+    BOOST_TEST((counted<1>::count() == std::pair(0, 0)));
+    BOOST_TEST((counted<2>::count() == std::pair(0, 0)));
+}
+
+} // namespace test_argument_moves
+
+namespace test_cached_dynamic_cast {
+
+using test_registry = test_registry_<__COUNTER__, counting_rtti<>>;
+using rtti = test_registry::rtti;
+
+struct Animal {
+    virtual ~Animal() = default;
+};
+
+struct Named {
+    virtual ~Named() = default;
+    std::string name = "Felix";
+};
+
+struct Cat : Named, virtual Animal {};
+struct Tiger : Cat {
+    int stripes = 42;
+};
+
+BOOST_OPENMETHOD_REGISTER(
+    use_classes<Animal, Named, Cat, Tiger, test_registry>);
+
+struct self_id;
+
+using self = method<
+    self_id, auto(virtual_<const Animal&>)->std::uintptr_t, test_registry>;
+
+auto self_cat(const Cat& cat) -> std::uintptr_t {
+    return reinterpret_cast<std::uintptr_t>(&cat);
+}
+
+auto address(const Cat& cat) -> std::uintptr_t {
+    return reinterpret_cast<std::uintptr_t>(&cat);
+}
+
+BOOST_OPENMETHOD_REGISTER(self::override<self_cat>);
+
+BOOST_AUTO_TEST_CASE(dynamic_casts_are_cached_per_class) {
+    initialize<test_registry>();
+
+    Cat cat;
+    Tiger tiger;
+    auto casts = rtti::casts;
+
+    BOOST_TEST(self::fn(cat) == address(cat));
+    BOOST_TEST(self::fn(cat) == address(cat));
+    BOOST_TEST(rtti::casts == casts + 1);
+
+    // The offset depends on the dynamic class.
+    BOOST_TEST(self::fn(tiger) == address(tiger));
+    BOOST_TEST(self::fn(tiger) == address(tiger));
+    BOOST_TEST(rtti::casts == casts + 2);
+
+    // Both offsets are cached.
+    for (int i = 0; i < 4; ++i) {
+        BOOST_TEST(self::fn(cat) == address(cat));
+        BOOST_TEST(self::fn(tiger) == address(tiger));
+    }
+
+    BOOST_TEST(rtti::casts == casts + 2);
+}
+
+struct Dog : virtual Animal {};
+
+BOOST_AUTO_TEST_CASE(failed_pointer_casts_yield_nullptr) {
+    using traits = virtual_traits<Animal*, test_registry>;
+
+    Cat cat;
+    Dog dog;
+    Animal* animal = &cat;
+
+    BOOST_TEST(traits::cast<Cat*>(animal) == &cat);
+    BOOST_TEST(traits::cast<Cat*>(animal) == &cat);
+
+    animal = &dog;
+    BOOST_TEST(traits::cast<Cat*>(animal) == nullptr);
+    BOOST_TEST(traits::cast<Cat*>(animal) == nullptr);
+
+    animal = nullptr;
+    BOOST_TEST(traits::cast<Cat*>(animal) == nullptr);
+
+    animal = &cat;
+    BOOST_TEST(traits::cast<Cat*>(animal) == &cat);
+}
+
+} // namespace test_cached_dynamic_cast
+
+namespace test_cached_dynamic_cast_id_zero {
+
+struct Animal {
+    explicit Animal(std::size_t type) : type(type) {
+    }
+
+    virtual ~Animal() = default;
+
+    static constexpr std::size_t static_type = 1;
+    std::size_t type;
+};
+
+struct Pad {
+    virtual ~Pad() = default;
+    char pad[32] = {};
+};
+
+struct Dog : Pad, virtual Animal {
+    Dog() : Animal(static_type) {
+    }
+
+    static constexpr std::size_t static_type = 0;
+};
+
+struct Cat : Pad, virtual Animal {
+    Cat() : Animal(static_type) {
+    }
+
+    static constexpr std::size_t static_type = 2;
+};
+
+// Uses the classes' own ids, including 0, and `dynamic_cast`.
+struct id_rtti : policies::std_rtti {
+    template<class Registry>
+    struct fn : policies::std_rtti::fn<Registry> {
+        template<class T>
+        static auto static_type() -> type_id {
+            if constexpr (std::is_base_of_v<Animal, T>) {
+                return type_id(T::static_type);
+            } else {
+                return policies::std_rtti::fn<Registry>::template static_type<
+                    T>();
+            }
+        }
+
+        template<class T>
+        static auto dynamic_type(const T& obj) -> type_id {
+            return type_id(obj.type);
+        }
+
+        static auto type_index(type_id type) -> type_id {
+            return type;
+        }
+
+        template<class Stream>
+        static void type_name(type_id type, Stream& stream) {
+            policies::rtti::defaults::type_name(type, stream);
+        }
+    };
+};
+
+using test_registry =
+    test_registry_<__COUNTER__, id_rtti>::without<policies::type_hash>;
+
+BOOST_OPENMETHOD_CLASSES(Animal, Dog, Cat, test_registry);
+
+BOOST_OPENMETHOD(
+    speak, (virtual_<const Animal&>), std::string, test_registry);
+
+BOOST_OPENMETHOD_OVERRIDE(speak, (const Dog& dog), std::string) {
+    return dog.static_type == 0 && dog.type == 0 ? "woof" : "?";
+}
+
+BOOST_OPENMETHOD_OVERRIDE(speak, (const Cat& cat), std::string) {
+    return cat.type == 2 ? "meow" : "?";
+}
+
+BOOST_AUTO_TEST_CASE(cached_dynamic_cast_with_id_zero) {
+    initialize<test_registry>();
+
+    Dog dog;
+    Cat cat;
+
+    for (int i = 0; i < 3; ++i) {
+        BOOST_TEST(speak(dog) == "woof");
+        BOOST_TEST(speak(cat) == "meow");
+    }
+
+    using traits = virtual_traits<Animal*, test_registry>;
+    Animal* animal = &dog;
+    BOOST_TEST(traits::cast<Dog*>(animal) == &dog);
+    animal = &cat;
+    BOOST_TEST(traits::cast<Dog*>(animal) == nullptr);
+    animal = &dog;
+    BOOST_TEST(traits::cast<Dog*>(animal) == &dog);
+}
+
+} // namespace test_cached_dynamic_cast_id_zero
@@ -107,6 +107,41 @@ BOOST_AUTO_TEST_CASE(intrusive_ptr_by_const_ref) {
 
 namespace BOOST_OPENMETHOD_GENSYM {
 
+// -----------------------------------------------------------------------------
+// pass virtual args by borrowed_intrusive_ptr
+
+MAKE_CLASSES();
+
+BOOST_OPENMETHOD(
+    name, (virtual_<borrowed_intrusive_ptr<const Animal>>), std::string);
+
+BOOST_OPENMETHOD_OVERRIDE(
+    name, (borrowed_intrusive_ptr<const Cat> cat), std::string) {
+    BOOST_TEST(cat->use_count() == 1u);
+    return cat->name + " the cat";
+}
+
+BOOST_OPENMETHOD_OVERRIDE(
+    name, (borrowed_intrusive_ptr<const Dog> dog), std::string) {
+    BOOST_TEST(dog->use_count() == 1u);
+    BOOST_TEST(dog.share()->use_count() == 2u);
+    return dog->name + " the dog";
+}
+
+BOOST_AUTO_TEST_CASE(intrusive_ptr_borrowed) {
+    initialize();
+
+    auto spot = boost::intrusive_ptr<const Dog>(new Dog("Spot"));
+    BOOST_TEST(name(spot) == "Spot the dog");
+
+    auto felix = boost::intrusive_ptr<const Cat>(new Cat("Felix"));
+    BOOST_TEST(name(felix) == "Felix the cat");
+    BOOST_TEST(felix->use_count() == 1u);
+}
+} // namespace BOOST_OPENMETHOD_GENSYM
+
+namespace BOOST_OPENMETHOD_GENSYM {
+
 // -----------------------------------------------------------------------------
 // virtual_ptr<intrusive_ptr> by value
 
@@ -0,0 +1,146 @@
+// Copyright (c) 2018-2025 Jean-Louis Leroy
+// Distributed under the Boost Software License, Version 1.0.
+// See accompanying file LICENSE_1_0.txt
+// or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <boost/openmethod.hpp>
+#include <boost/openmethod/policies/dispatch_profiler.hpp>
+#include <boost/openmethod/initialize.hpp>
+
+#include <cstdio>
+#include <string>
+#include <thread>
+
+#define BOOST_TEST_MODULE dispatch_profiler
+#include <boost/test/unit_test.hpp>
+
+#include "test_util.hpp"
+
+using namespace boost::openmethod;
+
+namespace TEST_NS {
+
+using registry =
+    test_registry_<__COUNTER__, policies::dispatch_profiler>::registry_type;
+using profiler = registry::profiler;
+
+struct Animal {
+    virtual ~Animal() = default;
+};
+
+struct Dog : Animal {};
+struct Cat : Animal {};
+struct Cow : Animal {};
+
+BOOST_OPENMETHOD_REGISTER(use_classes<Animal, Dog, Cat, Cow, registry>);
+
+struct cold_id;
+struct hot_id;
+struct meet_id;
+
+using cold = method<cold_id, int(virtual_<const Animal&>), registry>;
+using hot = method<hot_id, int(virtual_<const Animal&>), registry>;
+using meet = method<
+    meet_id, int(virtual_<const Animal&>, virtual_<const Animal&>), registry>;
+
+auto cold_animal(const Animal&) -> int {
+    return 0;
+}
+
+auto hot_animal(const Animal&) -> int {
+    return 1;
+}
+
+auto hot_dog(const Dog&) -> int {
+    return 2;
+}
+
+auto meet_animals(const Animal&, const Animal&) -> int {
+    return 0;
+}
+
+auto meet_dog_cat(const Dog&, const Cat&) -> int {
+    return 1;
+}
+
+BOOST_OPENMETHOD_REGISTER(cold::override<cold_animal>);
+BOOST_OPENMETHOD_REGISTER(hot::override<hot_animal, hot_dog>);
+BOOST_OPENMETHOD_REGISTER(meet::override<meet_animals, meet_dog_cat>);
+
+BOOST_AUTO_TEST_CASE(profile_guided_layout) {
+    Dog dog;
+    Cat cat;
+    Cow cow;
+
+    {
+        auto comp = initialize<registry>(retain_compiler());
+        // Without a profile, slots are allocated in declaration order.
+        BOOST_TEST(comp[cold::fn]->slots[0] < comp[hot::fn]->slots[0]);
+    }
+
+    BOOST_TEST(cold::fn(cow) == 0);
+
+    for (int i = 0; i < 10; ++i) {
+        BOOST_TEST(hot::fn(dog) == 2);
+        BOOST_TEST(meet::fn(dog, cat) == 1);
+    }
+
+    BOOST_TEST(profiler::count<Cow>(cold::fn, 0) == 1u);
+    BOOST_TEST(profiler::count<Dog>(hot::fn, 0) == 10u);
+    BOOST_TEST(profiler::count<Dog>(meet::fn, 0) == 10u);
+    BOOST_TEST(profiler::count<Cat>(meet::fn, 1) == 10u);
+    BOOST_TEST(profiler::count<Cat>(hot::fn, 0) == 0u);
+
+    std::string path = "test_dispatch_profiler.prof";
+    BOOST_TEST_REQUIRE(profiler::save(path));
+
+    {
+        auto comp = initialize<registry>(profile{path}, retain_compiler());
+        std::remove(path.c_str());
+
+        // The hottest method gets the first slot...
+        BOOST_TEST(comp[hot::fn]->slots[0] == 0u);
+        BOOST_TEST(comp[cold::fn]->slots[0] > comp[meet::fn]->slots[0]);
+
+        // ...and the hottest class is laid out first.
+        BOOST_TEST(
+            registry::static_vptr<Dog> < registry::static_vptr<Animal>);
+        BOOST_TEST(registry::static_vptr<Dog> < registry::static_vptr<Cat>);
+        BOOST_TEST(registry::static_vptr<Cat> < registry::static_vptr<Cow>);
+    }
+
+    BOOST_TEST(cold::fn(cow) == 0);
+    BOOST_TEST(hot::fn(dog) == 2);
+    BOOST_TEST(hot::fn(cat) == 1);
+    BOOST_TEST(meet::fn(dog, cat) == 1);
+    BOOST_TEST(meet::fn(cat, dog) == 0);
+
+    // A missing profile is not an error.
+    initialize<registry>(profile{"no-such-file.prof"});
+    BOOST_TEST(hot::fn(dog) == 2);
+}
+
+BOOST_AUTO_TEST_CASE(counters_are_merged_across_threads) {
+    initialize<registry>();
+
+    std::thread worker([]() {
+        Dog dog;
+
+        for (int i = 0; i < 5; ++i) {
+            hot::fn(dog);
+        }
+    });
+
+    worker.join();
+
+    Dog dog;
+    hot::fn(dog);
+
+    // The counters of the worker survive its exit.
+    BOOST_TEST(profiler::count<Dog>(hot::fn, 0) == 6u);
+
+    profiler::reset();
+    BOOST_TEST(profiler::count<Dog>(hot::fn, 0) == 0u);
+}
+
+} // namespace TEST_NS
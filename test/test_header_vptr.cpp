@@ -0,0 +1,143 @@
+// Copyright (c) 2018-2025 Jean-Louis Leroy
+// Distributed under the Boost Software License, Version 1.0.
+// See accompanying file LICENSE_1_0.txt
+// or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <boost/openmethod.hpp>
+#include <boost/openmethod/header_vptr.hpp>
+#include <boost/openmethod/policies/throw_error_handler.hpp>
+#include <boost/openmethod/initialize.hpp>
+
+#include <cstdint>
+#include <string>
+
+#define BOOST_TEST_MODULE header_vptr
+#include <boost/test/unit_test.hpp>
+
+#include "test_util.hpp"
+
+using namespace boost::openmethod;
+
+namespace TEST_NS {
+
+using registry = test_registry_<
+    __COUNTER__, counting_rtti<>, policies::header_vptr,
+    policies::runtime_checks, policies::throw_error_handler>::registry_type;
+
+// Stand-ins for third-party classes, which cannot derive from
+// inplace_vptr_base.
+struct Animal {
+    virtual ~Animal() = default;
+};
+
+struct Pet {
+    virtual ~Pet() = default;
+    std::string owner = "Bill";
+};
+
+struct Dog : Animal, Pet {
+    static inline int instances = 0;
+
+    Dog() {
+        ++instances;
+    }
+
+    ~Dog() {
+        --instances;
+    }
+};
+
+struct Cat : Animal {};
+
+BOOST_OPENMETHOD_CLASSES(Animal, Pet, Dog, Cat, registry);
+
+BOOST_OPENMETHOD(
+    name, (virtual_ptr<const Animal, registry>), std::string, registry);
+
+BOOST_OPENMETHOD_OVERRIDE(
+    name, (virtual_ptr<const Dog, registry>), std::string) {
+    return "dog";
+}
+
+BOOST_OPENMETHOD_OVERRIDE(
+    name, (virtual_ptr<const Cat, registry>), std::string) {
+    return "cat";
+}
+
+BOOST_OPENMETHOD(owner, (virtual_<const Pet&>), std::string, registry);
+
+BOOST_OPENMETHOD_OVERRIDE(owner, (const Dog& dog), std::string) {
+    return "dog of " + dog.owner;
+}
+
+BOOST_AUTO_TEST_CASE(header_vptr_dispatch) {
+    initialize<registry>();
+    registry::rtti::calls = 0;
+
+    {
+        header_vptr_unique_ptr<Animal, registry> animal =
+            make_header_vptr_unique<Dog, registry>();
+        BOOST_TEST(Dog::instances == 1);
+        BOOST_TEST(name(*animal) == "dog");
+        BOOST_TEST(owner(dynamic_cast<Pet&>(*animal)) == "dog of Bill");
+
+        virtual_ptr<const Animal, registry> ptr = *animal;
+        BOOST_TEST(ptr.vptr() == registry::static_vptr<Dog>);
+
+        std::shared_ptr<Animal> cat = make_header_vptr_shared<Cat, registry>();
+        BOOST_TEST(name(*cat) == "cat");
+
+        // The headers are not affected by a new initialization.
+        initialize<registry>();
+        BOOST_TEST(name(*animal) == "dog");
+        BOOST_TEST(name(*cat) == "cat");
+    }
+
+    BOOST_TEST(Dog::instances == 0);
+    BOOST_TEST(registry::rtti::calls == 0u);
+}
+
+BOOST_AUTO_TEST_CASE(header_vptr_allocator_adapter) {
+    initialize<registry>();
+
+    std::size_t count = 0;
+    counting_allocator<char> alloc(&count);
+
+    {
+        auto dog = allocate_header_vptr_unique<Dog, registry>(alloc);
+        BOOST_TEST(count == 1u);
+        BOOST_TEST(name(*dog) == "dog");
+
+        std::shared_ptr<Animal> cat =
+            allocate_header_vptr_shared<Cat, registry>(alloc);
+        BOOST_TEST(count == 3u); // object + control block
+        BOOST_TEST(name(*cat) == "cat");
+    }
+
+    BOOST_TEST(count == 0u);
+
+    header_vptr_allocator<registry> adapter;
+    Pet* pet = adapter.new_object<Dog>();
+    BOOST_TEST(owner(*pet) == "dog of Bill");
+    adapter.delete_object(pet);
+    BOOST_TEST(Dog::instances == 0);
+}
+
+BOOST_AUTO_TEST_CASE(header_vptr_provenance) {
+    initialize<registry>();
+
+    // An object that was not allocated with a header.
+    struct {
+        std::uintptr_t padding[4] = {};
+        Dog dog;
+    } storage;
+
+    try {
+        name(storage.dog);
+        BOOST_FAIL("expected bad_header");
+    } catch (const policies::header_vptr::bad_header& error) {
+        BOOST_TEST(error.type == registry::rtti::static_type<Dog>());
+    }
+}
+
+} // namespace TEST_NS
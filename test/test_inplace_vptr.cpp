@@ -18,6 +18,7 @@ struct test_registry : bom::default_registry::without<
 #include <boost/openmethod/inplace_vptr.hpp>
 #include <boost/openmethod/interop/std_shared_ptr.hpp>
 #include <boost/openmethod/initialize.hpp>
+#include <boost/openmethod/policies/throw_error_handler.hpp>
 
 #define BOOST_TEST_MODULE intrusive
 #include <boost/test/unit_test.hpp>
@@ -199,3 +200,156 @@ BOOST_AUTO_TEST_CASE(core_intrusive_vptr) {
     indirect_policy::static_vptr<Indirect> = nullptr;
     BOOST_TEST(boost_openmethod_vptr(i, nullptr) == nullptr);
 }
+
+struct compact_policy : test_registry::with<
+                            bom::policies::class_intervals,
+                            bom::policies::compact_inplace_vptr> {};
+
+struct Node : bom::inplace_vptr_base<Node, compact_policy> {};
+
+struct Leaf : Node, bom::inplace_vptr_derived<Leaf, Node> {};
+
+BOOST_OPENMETHOD(
+    node_kind, (virtual_<const Node&>), std::string, compact_policy);
+
+BOOST_OPENMETHOD_OVERRIDE(node_kind, (const Node&), std::string) {
+    return "node";
+}
+
+BOOST_OPENMETHOD_OVERRIDE(node_kind, (const Leaf&), std::string) {
+    return "leaf";
+}
+
+BOOST_AUTO_TEST_CASE(compact_inplace_vptr) {
+    static_assert(sizeof(Leaf) == sizeof(std::uint32_t));
+
+    bom::initialize<compact_policy>();
+    Node node;
+    Leaf leaf;
+
+    BOOST_TEST(
+        boost_openmethod_vptr(leaf, nullptr) ==
+        compact_policy::static_vptr<Leaf>);
+    BOOST_TEST(node_kind(node) == "node");
+    BOOST_TEST(node_kind(leaf) == "leaf");
+
+    // The class numbers survive a new initialization.
+    bom::initialize<compact_policy>();
+    BOOST_TEST(
+        boost_openmethod_vptr(leaf, nullptr) ==
+        compact_policy::static_vptr<Leaf>);
+    BOOST_TEST(node_kind(leaf) == "leaf");
+}
+
+struct checked_compact_policy
+    : test_registry::with<
+          bom::policies::class_intervals, bom::policies::compact_inplace_vptr,
+          bom::policies::runtime_checks, bom::policies::throw_error_handler> {
+};
+
+struct Early : bom::inplace_vptr_base<Early, checked_compact_policy> {};
+
+BOOST_OPENMETHOD(
+    early_kind, (virtual_<const Early&>), std::string, checked_compact_policy);
+
+BOOST_OPENMETHOD_OVERRIDE(early_kind, (const Early&), std::string) {
+    return "early";
+}
+
+BOOST_AUTO_TEST_CASE(compact_inplace_vptr_before_initialize) {
+    // Constructed before initialize: no class number.
+    Early early;
+
+    bom::initialize<checked_compact_policy>();
+    BOOST_CHECK_THROW(early_kind(early), bom::missing_class);
+
+    Early late;
+    BOOST_TEST(early_kind(late) == "early");
+}
+
+// Shape's constructor reads the v-table pointer before it is set, which is
+// an error under runtime_checks.
+struct final_policy
+    : test_registry::with<bom::policies::final_inplace_vptr>::without<
+          bom::policies::runtime_checks> {};
+
+struct Shape : bom::inplace_vptr_base<Shape, final_policy> {
+    Shape();
+    bom::vptr_type vptr_in_constructor;
+};
+
+auto shape_vptr(const Shape& shape) -> bom::vptr_type {
+    return boost_openmethod_vptr(shape, nullptr);
+}
+
+Shape::Shape() {
+    vptr_in_constructor = shape_vptr(*this);
+}
+
+struct Named : bom::inplace_vptr_base<Named, final_policy> {};
+
+struct Polygon : Shape, bom::inplace_vptr_derived<Polygon, Shape> {};
+
+struct Square final : Polygon,
+                      Named,
+                      bom::inplace_vptr_derived<Square, Polygon, Named> {};
+
+BOOST_OPENMETHOD(
+    shape_kind, (virtual_<const Shape&>), std::string, final_policy);
+
+BOOST_OPENMETHOD_OVERRIDE(shape_kind, (const Square&), std::string) {
+    return "square";
+}
+
+BOOST_OPENMETHOD(
+    name_kind, (virtual_<const Named&>), std::string, final_policy);
+
+BOOST_OPENMETHOD_OVERRIDE(name_kind, (const Square&), std::string) {
+    return "named square";
+}
+
+BOOST_AUTO_TEST_CASE(final_inplace_vptr) {
+    bom::initialize<final_policy>();
+    Square square;
+
+    // Only the most derived constructor sets the vptr, in each root.
+    BOOST_TEST(square.vptr_in_constructor == nullptr);
+    BOOST_TEST(
+        boost_openmethod_vptr(static_cast<const Shape&>(square), nullptr) ==
+        final_policy::static_vptr<Square>);
+    BOOST_TEST(
+        boost_openmethod_vptr(static_cast<const Named&>(square), nullptr) ==
+        final_policy::static_vptr<Square>);
+    BOOST_TEST(shape_kind(square) == "square");
+    BOOST_TEST(name_kind(square) == "named square");
+}
+
+struct checked_final_policy
+    : test_registry::with<
+          bom::policies::final_inplace_vptr, bom::policies::runtime_checks,
+          bom::policies::throw_error_handler> {};
+
+struct Vehicle : bom::inplace_vptr_base<Vehicle, checked_final_policy> {};
+
+struct Car : Vehicle, bom::inplace_vptr_derived<Car, Vehicle> {};
+
+struct Sedan final : Car, bom::inplace_vptr_derived<Sedan, Car> {};
+
+BOOST_OPENMETHOD(
+    vehicle_kind, (virtual_<const Vehicle&>), std::string,
+    checked_final_policy);
+
+BOOST_OPENMETHOD_OVERRIDE(vehicle_kind, (const Vehicle&), std::string) {
+    return "vehicle";
+}
+
+BOOST_AUTO_TEST_CASE(final_inplace_vptr_non_final_class) {
+    bom::initialize<checked_final_policy>();
+
+    // Car is not final: its v-table pointer is not set.
+    Car car;
+    BOOST_CHECK_THROW(vehicle_kind(car), bom::missing_class);
+
+    Sedan sedan;
+    BOOST_TEST(vehicle_kind(sedan) == "vehicle");
+}
@@ -0,0 +1,85 @@
+// Copyright (c) 2018-2025 Jean-Louis Leroy
+// Distributed under the Boost Software License, Version 1.0.
+// See accompanying file LICENSE_1_0.txt
+// or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <boost/openmethod.hpp>
+#include <boost/openmethod/policies/mmap_arena.hpp>
+#include <boost/openmethod/initialize.hpp>
+
+#include <string>
+
+#define BOOST_TEST_MODULE mmap_arena
+#include <boost/test/unit_test.hpp>
+
+#include "test_util.hpp"
+
+using namespace boost::openmethod;
+
+namespace TEST_NS {
+
+using registry = test_registry_<
+    __COUNTER__, policies::mmap_arena<>, policies::runtime_checks>;
+using arena = registry::arena;
+
+struct Animal {
+    virtual ~Animal() = default;
+};
+
+struct Dog : Animal {};
+struct Cat : Animal {};
+
+BOOST_OPENMETHOD_CLASSES(Animal, Dog, Cat, registry);
+
+BOOST_OPENMETHOD(name, (virtual_<const Animal&>), std::string, registry);
+
+BOOST_OPENMETHOD_OVERRIDE(name, (const Dog&), std::string) {
+    return "dog";
+}
+
+BOOST_OPENMETHOD_OVERRIDE(name, (const Cat&), std::string) {
+    return "cat";
+}
+
+BOOST_OPENMETHOD(
+    meet, (virtual_<const Animal&>, virtual_<const Animal&>), std::string,
+    registry);
+
+BOOST_OPENMETHOD_OVERRIDE(meet, (const Animal&, const Animal&), std::string) {
+    return "ignore";
+}
+
+BOOST_OPENMETHOD_OVERRIDE(meet, (const Dog&, const Cat&), std::string) {
+    return "chase";
+}
+
+void check_runtime_data() {
+    BOOST_TEST(arena::contains(registry::static_vptr<Dog>));
+    BOOST_TEST(arena::contains(registry::static_vptr<Cat>));
+    BOOST_TEST(arena::contains(
+        detail::vptr_vector_vptrs<registry::registry_type>.data()));
+    BOOST_TEST(arena::contains(
+        detail::fast_perfect_hash_control<registry::registry_type>.data()));
+
+    BOOST_TEST(name(Dog()) == "dog");
+    BOOST_TEST(name(Cat()) == "cat");
+    BOOST_TEST(meet(Dog(), Cat()) == "chase");
+    BOOST_TEST(meet(Cat(), Dog()) == "ignore");
+}
+
+BOOST_AUTO_TEST_CASE(runtime_data_in_arena) {
+    initialize<registry>();
+    check_runtime_data();
+
+    // The arena is recycled.
+    initialize<registry>();
+    check_runtime_data();
+
+    finalize<registry>();
+    BOOST_TEST(!arena::contains(registry::static_vptr<Dog>));
+
+    initialize<registry>();
+    check_runtime_data();
+}
+
+} // namespace TEST_NS
@@ -0,0 +1,168 @@
+// Copyright (c) 2018-2025 Jean-Louis Leroy
+// Distributed under the Boost Software License, Version 1.0.
+// See accompanying file LICENSE_1_0.txt
+// or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <boost/openmethod.hpp>
+#include <boost/openmethod/page_arena.hpp>
+#include <boost/openmethod/policies/throw_error_handler.hpp>
+#include <boost/openmethod/initialize.hpp>
+
+#include <string>
+#include <vector>
+
+#define BOOST_TEST_MODULE page_arena
+#include <boost/test/unit_test.hpp>
+
+#include "test_util.hpp"
+
+using namespace boost::openmethod;
+
+namespace TEST_NS {
+
+constexpr std::size_t page_size = 4096;
+
+using registry = test_registry_<
+    __COUNTER__, counting_rtti<>, policies::page_vptr<page_size>,
+    policies::runtime_checks, policies::throw_error_handler>::registry_type;
+
+struct Node {
+    virtual ~Node() = default;
+};
+
+struct Named {
+    virtual ~Named() = default;
+    std::string name;
+};
+
+struct Literal : Node {
+    static inline int instances = 0;
+
+    explicit Literal(int value) : value(value) {
+        ++instances;
+    }
+
+    ~Literal() {
+        --instances;
+    }
+
+    int value;
+};
+
+struct Variable : Node, Named {};
+
+BOOST_OPENMETHOD_CLASSES(Node, Named, Literal, Variable, registry);
+
+BOOST_OPENMETHOD(
+    describe, (virtual_ptr<const Node, registry>), std::string, registry);
+
+BOOST_OPENMETHOD_OVERRIDE(
+    describe, (virtual_ptr<const Literal, registry> node), std::string) {
+    return std::to_string(node->value);
+}
+
+BOOST_OPENMETHOD_OVERRIDE(
+    describe, (virtual_ptr<const Variable, registry> node), std::string) {
+    return node->name;
+}
+
+BOOST_OPENMETHOD(label, (virtual_<const Named&>), std::string, registry);
+
+BOOST_OPENMETHOD_OVERRIDE(label, (const Variable& var), std::string) {
+    return "var " + var.name;
+}
+
+BOOST_AUTO_TEST_CASE(page_arena_dispatch) {
+    initialize<registry>();
+    registry::rtti::calls = 0;
+
+    page_arena<registry, page_size> arena;
+    std::vector<Node*> nodes;
+    constexpr int count = 2 * page_size / sizeof(Literal);
+
+    for (int i = 0; i < count; ++i) {
+        nodes.push_back(arena.new_object<Literal>(i));
+    }
+
+    auto x = arena.new_object<Variable>();
+    x->name = "x";
+    nodes.push_back(x);
+
+    BOOST_TEST(arena.size() == std::size_t(count + 1));
+    BOOST_TEST(arena.page_count() >= 3u);
+    BOOST_TEST(Literal::instances == count);
+
+    for (int i = 0; i < count; ++i) {
+        BOOST_TEST(describe(*nodes[i]) == std::to_string(i));
+    }
+
+    BOOST_TEST(describe(*x) == "x");
+    BOOST_TEST(label(*static_cast<Named*>(x)) == "var x");
+
+    virtual_ptr<Node, registry> ptr = *nodes[1];
+    BOOST_TEST(ptr.vptr() == registry::static_vptr<Literal>);
+
+    // The page headers are not affected by a new initialization.
+    initialize<registry>();
+    BOOST_TEST(describe(*nodes[0]) == "0");
+    BOOST_TEST(registry::rtti::calls == 0u);
+
+    // Freed slots are reused, without allocating new pages.
+    auto pages = arena.page_count();
+    auto freed = nodes[3];
+    arena.delete_object(freed);
+    BOOST_TEST(Literal::instances == count - 1);
+    BOOST_TEST(arena.new_object<Literal>(42) == freed);
+    BOOST_TEST(arena.page_count() == pages);
+
+    // Delete via a base that is not at offset 0.
+    arena.delete_object(static_cast<Named*>(x));
+    BOOST_TEST((arena.new_object<Variable>() == x));
+
+    for (auto node : nodes) {
+        arena.delete_object(node);
+    }
+
+    BOOST_TEST(arena.size() == 0u);
+    BOOST_TEST(Literal::instances == 0);
+}
+
+BOOST_AUTO_TEST_CASE(page_arena_pools_per_arena) {
+    initialize<registry>();
+
+    page_arena<registry, page_size> literals, variables;
+
+    auto literal = literals.new_object<Literal>(7);
+    // `Variable` gets a pool in `variables` only.
+    auto var = variables.new_object<Variable>();
+    var->name = "y";
+
+    BOOST_TEST(literals.page_count() == 1u);
+    BOOST_TEST(variables.page_count() == 1u);
+    BOOST_TEST(describe(*literal) == "7");
+    BOOST_TEST(describe(*var) == "y");
+
+    literals.delete_object(literal);
+    variables.delete_object(var);
+}
+
+// An object with a page-aligned address, but not allocated from an arena.
+struct alignas(page_size) fake_page {
+    char header[64] = {};
+    Literal literal{0};
+};
+
+BOOST_AUTO_TEST_CASE(page_arena_provenance) {
+    initialize<registry>();
+
+    static fake_page storage;
+
+    try {
+        describe(storage.literal);
+        BOOST_FAIL("expected bad_page");
+    } catch (const policies::page_vptr<page_size>::bad_page& error) {
+        BOOST_TEST(error.type == registry::rtti::static_type<Literal>());
+    }
+}
+
+} // namespace TEST_NS
@@ -0,0 +1,109 @@
+// Copyright (c) 2018-2025 Jean-Louis Leroy
+// Distributed under the Boost Software License, Version 1.0.
+// See accompanying file LICENSE_1_0.txt
+// or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <boost/openmethod.hpp>
+#include <boost/openmethod/segmented_collection.hpp>
+#include <boost/openmethod/initialize.hpp>
+
+#include <string>
+
+#define BOOST_TEST_MODULE segmented_collection
+#include <boost/test/unit_test.hpp>
+
+#include "test_util.hpp"
+
+using namespace boost::openmethod;
+
+namespace TEST_NS {
+
+using registry = test_registry_<__COUNTER__, counting_rtti<>>::registry_type;
+using rtti = registry::rtti;
+
+struct Named {
+    virtual ~Named() = default;
+    std::string name;
+};
+
+struct Animal {
+    virtual ~Animal() = default;
+};
+
+struct Dog : Named, Animal {
+    explicit Dog(std::string name) {
+        this->name = std::move(name);
+    }
+};
+
+struct Cat : Animal {};
+
+BOOST_OPENMETHOD_CLASSES(Animal, Named, Dog, Cat, registry);
+
+struct speak_id;
+struct update_id;
+
+using speak = method<
+    speak_id, void(virtual_ptr<const Animal, registry>, std::string&),
+    registry>;
+
+auto speak_dog(virtual_ptr<const Dog, registry> dog, std::string& out)
+    -> void {
+    out += dog->name + " barks; ";
+}
+
+auto speak_cat(virtual_ptr<const Cat, registry>, std::string& out) -> void {
+    out += "meow; ";
+}
+
+BOOST_OPENMETHOD_REGISTER(speak::override<speak_dog, speak_cat>);
+
+using update =
+    method<update_id, void(virtual_<Animal&>, int, int&), registry>;
+
+auto update_dog(Dog&, int step, int& total) -> void {
+    total += 10 * step;
+}
+
+auto update_cat(Cat&, int step, int& total) -> void {
+    total += step;
+}
+
+BOOST_OPENMETHOD_REGISTER(update::override<update_dog, update_cat>);
+
+BOOST_AUTO_TEST_CASE(segmented_collection_for_each) {
+    initialize<registry>();
+
+    segmented_collection<Animal, registry> animals;
+    BOOST_TEST(animals.empty());
+
+    animals.emplace<Dog>("Snoopy");
+    animals.insert(Cat());
+    auto& rex = animals.emplace<Dog>("Rex");
+    animals.emplace<Cat>();
+
+    BOOST_TEST(animals.size() == 4u);
+    BOOST_TEST(animals.segment_count() == 2u);
+    BOOST_TEST(rex.name == "Rex");
+
+    // Objects are visited segment by segment, with no v-table lookup.
+    std::string out;
+    rtti::calls = 0;
+    static_cast<const segmented_collection<Animal, registry>&>(animals)
+        .for_each(speak::fn, out);
+    BOOST_TEST(out == "Snoopy barks; Rex barks; meow; meow; ");
+    BOOST_TEST(rtti::calls == 0u);
+
+    // With a reference parameter, the call is resolved once per segment.
+    int total = 0;
+    animals.for_each(update::fn, 2, total);
+    BOOST_TEST(total == 44);
+    BOOST_TEST(rtti::calls == 2u);
+
+    animals.clear();
+    BOOST_TEST(animals.empty());
+    animals.for_each(update::fn, 2, total);
+    BOOST_TEST(total == 44);
+}
+
+} // namespace TEST_NS
@@ -0,0 +1,292 @@
+// Copyright (c) 2018-2025 Jean-Louis Leroy
+// Distributed under the Boost Software License, Version 1.0.
+// See accompanying file LICENSE_1_0.txt
+// or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <boost/openmethod.hpp>
+#include <boost/openmethod/policies/static_arena.hpp>
+#include <boost/openmethod/policies/throw_error_handler.hpp>
+#include <boost/openmethod/initialize.hpp>
+
+#include <cstdlib>
+#include <new>
+#include <thread>
+
+#define BOOST_TEST_MODULE static_arena
+#include <boost/test/unit_test.hpp>
+
+#include "test_util.hpp"
+
+using namespace boost::openmethod;
+
+namespace {
+
+// Per thread, so that allocations made by other threads are not counted.
+thread_local std::size_t allocations = 0;
+
+} // namespace
+
+auto operator new(std::size_t size) -> void* {
+    ++allocations;
+
+    if (auto p = std::malloc(size ? size : 1)) {
+        return p;
+    }
+
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept {
+    std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept {
+    std::free(p);
+}
+
+namespace TEST_NS {
+
+using registry = test_registry_<
+    __COUNTER__, policies::static_arena<4096>, policies::runtime_checks>;
+using arena = registry::arena;
+
+struct Animal {
+    virtual ~Animal() = default;
+};
+
+struct Dog : Animal {};
+struct Cat : Animal {};
+
+BOOST_OPENMETHOD_CLASSES(Animal, Dog, Cat, registry);
+
+BOOST_OPENMETHOD(legs, (virtual_<const Animal&>), int, registry);
+
+BOOST_OPENMETHOD_OVERRIDE(legs, (const Animal&), int) {
+    return 4;
+}
+
+BOOST_OPENMETHOD(
+    meet, (virtual_<const Animal&>, virtual_<const Animal&>), int, registry);
+
+BOOST_OPENMETHOD_OVERRIDE(meet, (const Animal&, const Animal&), int) {
+    return 0;
+}
+
+BOOST_OPENMETHOD_OVERRIDE(meet, (const Dog&, const Cat&), int) {
+    return 1;
+}
+
+BOOST_AUTO_TEST_CASE(no_allocation) {
+    auto before_initialize = allocations;
+    initialize<registry>();
+    BOOST_TEST(allocations == before_initialize);
+
+    BOOST_TEST(arena::scratch_used() > 0u);
+    BOOST_TEST(arena::scratch_used() <= arena::scratch_capacity);
+    BOOST_TEST(arena::used() > 0u);
+    BOOST_TEST(arena::used() <= arena::capacity);
+    BOOST_TEST(arena::contains(registry::static_vptr<Dog>));
+    BOOST_TEST(arena::contains(
+        detail::vptr_vector_vptrs<registry::registry_type>.data()));
+    BOOST_TEST(arena::contains(
+        detail::fast_perfect_hash_control<registry::registry_type>.data()));
+
+    Dog dog;
+    Cat cat;
+    int results[4];
+
+    auto before = allocations;
+    results[0] = legs(dog);
+    results[1] = legs(cat);
+    results[2] = meet(dog, cat);
+    results[3] = meet(cat, dog);
+    auto after = allocations;
+
+    BOOST_TEST(after == before);
+    BOOST_TEST(results[0] == 4);
+    BOOST_TEST(results[1] == 4);
+    BOOST_TEST(results[2] == 1);
+    BOOST_TEST(results[3] == 0);
+
+    // The buffers are recycled.
+    auto used = arena::used();
+    auto scratch_used = arena::scratch_used();
+    before_initialize = allocations;
+    initialize<registry>();
+    BOOST_TEST(allocations == before_initialize);
+    BOOST_TEST(arena::used() == used);
+    BOOST_TEST(arena::scratch_used() == scratch_used);
+    BOOST_TEST(meet(dog, cat) == 1);
+}
+
+} // namespace TEST_NS
+
+namespace TEST_NS {
+
+using registry = test_registry_<
+    __COUNTER__, policies::static_arena<64, 16384>,
+    policies::throw_error_handler>;
+
+struct Animal {
+    virtual ~Animal() = default;
+};
+
+struct Dog : Animal {};
+struct Cat : Animal {};
+
+BOOST_OPENMETHOD_CLASSES(Animal, Dog, Cat, registry);
+
+BOOST_OPENMETHOD(
+    meet, (virtual_<const Animal&>, virtual_<const Animal&>), int, registry);
+
+BOOST_OPENMETHOD_OVERRIDE(meet, (const Dog&, const Cat&), int) {
+    return 1;
+}
+
+BOOST_AUTO_TEST_CASE(capacity_exceeded) {
+    using capacity_error = policies::static_arena<64, 16384>::capacity_error;
+
+    try {
+        initialize<registry>();
+        BOOST_FAIL("expected capacity_error");
+    } catch (const capacity_error& error) {
+        BOOST_TEST(error.capacity == 64u);
+        BOOST_TEST(error.requested > 64u);
+    }
+}
+
+} // namespace TEST_NS
+
+namespace TEST_NS {
+
+using registry = test_registry_<
+    __COUNTER__, policies::static_arena<4096, 256>,
+    policies::throw_error_handler>;
+
+struct Animal {
+    virtual ~Animal() = default;
+};
+
+struct Dog : Animal {};
+struct Cat : Animal {};
+
+BOOST_OPENMETHOD_CLASSES(Animal, Dog, Cat, registry);
+
+BOOST_OPENMETHOD(
+    meet, (virtual_<const Animal&>, virtual_<const Animal&>), int, registry);
+
+BOOST_OPENMETHOD_OVERRIDE(meet, (const Dog&, const Cat&), int) {
+    return 1;
+}
+
+BOOST_AUTO_TEST_CASE(scratch_capacity_exceeded) {
+    using scratch_capacity_error =
+        policies::static_arena<4096, 256>::scratch_capacity_error;
+
+    try {
+        initialize<registry>();
+        BOOST_FAIL("expected scratch_capacity_error");
+    } catch (const scratch_capacity_error& error) {
+        BOOST_TEST(error.capacity == 256u);
+        BOOST_TEST(error.requested > 256u);
+    }
+}
+
+} // namespace TEST_NS
+
+namespace TEST_NS {
+
+using registry = test_registry_<__COUNTER__, policies::static_arena<4096>>;
+using heap_registry = test_registry_<__COUNTER__>;
+
+struct Animal {
+    virtual ~Animal() = default;
+};
+
+struct Dog : Animal {};
+struct Cat : Animal {};
+
+BOOST_OPENMETHOD_CLASSES(Animal, Dog, Cat, registry);
+BOOST_OPENMETHOD_CLASSES(Animal, Dog, Cat, heap_registry);
+
+BOOST_OPENMETHOD(
+    meet, (virtual_<const Animal&>, virtual_<const Animal&>), int, registry);
+
+BOOST_OPENMETHOD_OVERRIDE(meet, (const Dog&, const Cat&), int) {
+    return 1;
+}
+
+BOOST_OPENMETHOD(
+    greet, (virtual_<const Animal&>, virtual_<const Animal&>), int,
+    heap_registry);
+
+BOOST_OPENMETHOD_OVERRIDE(greet, (const Dog&, const Cat&), int) {
+    return 2;
+}
+
+BOOST_AUTO_TEST_CASE(concurrent_initialize) {
+    // Initializing a registry that allocates scratch memory from the heap, on
+    // another thread, does not make this thread's `initialize` use it.
+    std::thread worker([]() {
+        for (int i = 0; i < 100; ++i) {
+            initialize<heap_registry>();
+        }
+    });
+
+    auto before = allocations;
+
+    for (int i = 0; i < 100; ++i) {
+        initialize<registry>();
+    }
+
+    auto after = allocations;
+    worker.join();
+
+    BOOST_TEST(after == before);
+    BOOST_TEST(meet(Dog(), Cat()) == 1);
+    BOOST_TEST(greet(Dog(), Cat()) == 2);
+}
+
+} // namespace TEST_NS
+
+namespace TEST_NS {
+
+using registry = test_registry_<__COUNTER__, policies::static_arena<4096>>;
+using arena = registry::arena;
+
+struct Animal {
+    virtual ~Animal() = default;
+};
+
+struct Dog : Animal {};
+struct Cat : Animal {};
+
+BOOST_OPENMETHOD_CLASSES(Animal, Dog, Cat, registry);
+
+BOOST_OPENMETHOD(
+    meet, (virtual_<const Animal&>, virtual_<const Animal&>), int, registry);
+
+BOOST_OPENMETHOD_OVERRIDE(meet, (const Dog&, const Cat&), int) {
+    return 1;
+}
+
+BOOST_AUTO_TEST_CASE(retained_compiler_pins_scratch) {
+    initialize<registry>();
+    auto scratch_used = arena::scratch_used();
+
+    {
+        auto comp = initialize<registry>(retain_compiler());
+        BOOST_TEST(!comp.classes.empty());
+
+        // The temporary data of this call is allocated above the compiler's.
+        initialize<registry>();
+        BOOST_TEST(arena::scratch_used() > scratch_used);
+        BOOST_TEST(meet(Dog(), Cat()) == 1);
+    }
+
+    // Released with the compiler.
+    initialize<registry>();
+    BOOST_TEST(arena::scratch_used() == scratch_used);
+}
+
+} // namespace TEST_NS
@@ -7,6 +7,8 @@
 #define BOOST_OPENMETHOD_TEST_HELPERS_HPP
 
 #include <iostream>
+#include <memory>
+#include <utility>
 
 #include <boost/openmethod/core.hpp>
 #include <boost/openmethod/initialize.hpp>
@@ -27,6 +29,68 @@ struct test_registry_ : boost::openmethod::default_registry::with<
 
 #define TEST_NS BOOST_PP_CAT(test, __COUNTER__)
 
+// An rtti policy that counts the calls to `dynamic_type` and
+// `dynamic_cast_ref`, per registry.
+template<class Rtti = boost::openmethod::policies::std_rtti>
+struct counting_rtti : Rtti {
+    template<class Registry>
+    struct fn : Rtti::template fn<Registry> {
+        using base = typename Rtti::template fn<Registry>;
+
+        static inline std::size_t calls = 0;
+        static inline std::size_t casts = 0;
+
+        template<class Class>
+        static auto dynamic_type(const Class& obj)
+            -> boost::openmethod::type_id {
+            ++calls;
+            return base::dynamic_type(obj);
+        }
+
+        template<typename D, typename B>
+        static auto dynamic_cast_ref(B&& obj) -> D {
+            ++casts;
+            return base::template dynamic_cast_ref<D>(std::forward<B>(obj));
+        }
+    };
+};
+
+// An allocator that counts the blocks it has allocated and not deallocated.
+template<typename T>
+struct counting_allocator {
+    using value_type = T;
+
+    std::size_t* count;
+
+    explicit counting_allocator(std::size_t* count) : count(count) {
+    }
+
+    template<typename U>
+    counting_allocator(const counting_allocator<U>& other)
+        : count(other.count) {
+    }
+
+    auto allocate(std::size_t n) -> T* {
+        ++*count;
+        return std::allocator<T>().allocate(n);
+    }
+
+    auto deallocate(T* p, std::size_t n) -> void {
+        --*count;
+        std::allocator<T>().deallocate(p, n);
+    }
+
+    template<typename U>
+    auto operator==(const counting_allocator<U>& other) const -> bool {
+        return count == other.count;
+    }
+
+    template<typename U>
+    auto operator!=(const counting_allocator<U>& other) const -> bool {
+        return count != other.count;
+    }
+};
+
 struct capture_cout {
     capture_cout(std::streambuf* new_buffer)
         : old(std::cout.rdbuf(new_buffer)) {
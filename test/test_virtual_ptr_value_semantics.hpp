@@ -11,6 +11,7 @@
 #include <boost/openmethod.hpp>
 #include <boost/openmethod/initialize.hpp>
 #include <boost/openmethod/policies/vptr_map.hpp>
+#include <boost/openmethod/policies/vptr_flat_map.hpp>
 #include <boost/openmethod/interop/std_shared_ptr.hpp>
 #include <boost/openmethod/interop/boost_intrusive_ptr.hpp>
 #include <boost/openmethod/interop/std_unique_ptr.hpp>
@@ -67,8 +68,14 @@ struct direct_map
 
 struct indirect_map : direct_map::with<indirect_vptr> {};
 
+struct direct_flat_map
+    : test_registry_<__COUNTER__>::with<vptr_flat_map>::without<type_hash> {};
+
+struct indirect_flat_map : direct_flat_map::with<indirect_vptr> {};
+
 using test_policies = boost::mp11::mp_list<
-    direct_vector, indirect_vector, direct_map, indirect_map>;
+    direct_vector, indirect_vector, direct_map, indirect_map, direct_flat_map,
+    indirect_flat_map>;
 
 using test_classes = boost::mp11::mp_list<Dog, Cat>;
 
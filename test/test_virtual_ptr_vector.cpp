@@ -0,0 +1,135 @@
+// Copyright (c) 2018-2025 Jean-Louis Leroy
+// Distributed under the Boost Software License, Version 1.0.
+// See accompanying file LICENSE_1_0.txt
+// or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <boost/openmethod.hpp>
+#include <boost/openmethod/virtual_ptr_vector.hpp>
+#include <boost/openmethod/initialize.hpp>
+
+#include <string>
+
+#define BOOST_TEST_MODULE virtual_ptr_vector
+#include <boost/test/unit_test.hpp>
+
+#include "test_util.hpp"
+
+using namespace boost::openmethod;
+
+namespace TEST_NS {
+
+// runtime_checks makes final_virtual_ptr check the dynamic type.
+template<int N, class... Policies>
+using registries = boost::mp11::mp_list<
+    typename test_registry_<N, counting_rtti<>>::template without<
+        policies::runtime_checks>,
+    typename test_registry_<N + 1, counting_rtti<>, policies::indirect_vptr>::
+        template without<policies::runtime_checks>>;
+
+struct Animal {
+    virtual ~Animal() = default;
+};
+
+struct Dog : Animal {};
+struct Cat : Animal {};
+
+struct name_id;
+struct meet_id;
+
+template<class Registry>
+struct animal_overriders {
+    using animal_ptr = virtual_ptr<Animal, Registry>;
+
+    static auto name_dog(virtual_ptr<Dog, Registry>) -> std::string {
+        return "dog";
+    }
+
+    static auto name_cat(virtual_ptr<Cat, Registry>) -> std::string {
+        return "cat";
+    }
+
+    static auto meet_animals(animal_ptr, animal_ptr, std::string& out)
+        -> void {
+        out += "ignore ";
+    }
+
+    static auto meet_dog_cat(
+        virtual_ptr<Dog, Registry>, virtual_ptr<Cat, Registry>,
+        std::string& out) -> void {
+        out += "chase ";
+    }
+};
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(
+    virtual_ptr_vector_dispatch, Registry, registries<__COUNTER__>) {
+    using animal_ptr = virtual_ptr<Animal, Registry>;
+    using name = method<name_id, std::string(animal_ptr), Registry>;
+    using meet = method<
+        meet_id, void(animal_ptr, animal_ptr, std::string&), Registry>;
+    using overriders = animal_overriders<Registry>;
+
+    BOOST_OPENMETHOD_REGISTER(use_classes<Animal, Dog, Cat, Registry>);
+    BOOST_OPENMETHOD_REGISTER(
+        typename name::template override<
+            overriders::name_dog, overriders::name_cat>);
+    BOOST_OPENMETHOD_REGISTER(
+        typename meet::template override<
+            overriders::meet_animals, overriders::meet_dog_cat>);
+
+    initialize<Registry>();
+
+    using rtti = typename Registry::rtti;
+    Dog dog;
+    Cat cat;
+
+    virtual_ptr_vector<Animal, Registry> animals;
+    animals.reserve(3);
+    rtti::calls = 0;
+    animals.push_back(final_virtual_ptr<Registry>(dog));
+    animals.push_back(final_virtual_ptr<Registry>(cat));
+    BOOST_TEST(rtti::calls == 0u);
+    animals.push_back(static_cast<Animal&>(dog));
+    BOOST_TEST(rtti::calls == 1u);
+
+    BOOST_TEST(animals.size() == 3u);
+    BOOST_TEST(animals[1].get() == &cat);
+    BOOST_TEST(animals[2].vptr() == Registry::template static_vptr<Dog>);
+    BOOST_TEST(name::fn(animals[0]) == "dog");
+
+    std::string names;
+
+    for (auto animal : animals) {
+        names += name::fn(animal) + " ";
+    }
+
+    BOOST_TEST(names == "dog cat dog ");
+
+    std::string out;
+    animals.for_each(meet::fn, final_virtual_ptr<Registry>(cat), out);
+    BOOST_TEST(out == "chase ignore chase ");
+    BOOST_TEST(rtti::calls == 1u);
+
+    animals.pop_back();
+    BOOST_TEST(animals.size() == 2u);
+    animals.clear();
+    BOOST_TEST(animals.empty());
+
+    // More elements than fit in a batch.
+    std::string expected;
+
+    for (int i = 0; i < 37; ++i) {
+        if (i % 3 == 0) {
+            animals.push_back(final_virtual_ptr<Registry>(cat));
+            expected += "ignore ";
+        } else {
+            animals.push_back(final_virtual_ptr<Registry>(dog));
+            expected += "chase ";
+        }
+    }
+
+    out.clear();
+    animals.for_each(meet::fn, final_virtual_ptr<Registry>(cat), out);
+    BOOST_TEST(out == expected);
+}
+
+} // namespace TEST_NS
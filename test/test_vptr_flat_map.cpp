@@ -0,0 +1,98 @@
+// Copyright (c) 2018-2025 Jean-Louis Leroy
+// Distributed under the Boost Software License, Version 1.0.
+// See accompanying file LICENSE_1_0.txt
+// or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <boost/openmethod.hpp>
+#include <boost/openmethod/policies/vptr_flat_map.hpp>
+#include <boost/openmethod/policies/throw_error_handler.hpp>
+#include <boost/openmethod/initialize.hpp>
+
+#define BOOST_TEST_MODULE vptr_flat_map
+#include <boost/test/unit_test.hpp>
+
+#include "test_util.hpp"
+
+using namespace boost::openmethod;
+using namespace boost::mp11;
+
+namespace {
+
+struct Base {
+    virtual ~Base() = default;
+};
+
+template<class N>
+struct Leaf : Base {};
+
+struct Unregistered : Base {};
+
+template<class N>
+auto leaf_index(const Leaf<N>&) -> std::size_t {
+    return N::value;
+}
+
+// Enough classes to fill several groups of 16 slots.
+constexpr std::size_t leaves = 100;
+
+template<class Registry>
+using leaf_classes = mp_push_back<
+    mp_push_front<mp_transform<Leaf, mp_iota_c<leaves>>, Base>, Registry>;
+
+template<int N>
+struct direct_registry : test_registry_<
+                             N, policies::vptr_flat_map,
+                             policies::runtime_checks,
+                             policies::throw_error_handler>::
+                             template without<policies::type_hash> {};
+
+template<int N>
+struct indirect_registry
+    : direct_registry<N>::template with<policies::indirect_vptr> {};
+
+template<int N>
+using registries = mp_list<direct_registry<N>, indirect_registry<N>>;
+
+template<class Registry>
+struct index_id;
+
+template<class Registry>
+using index_method = method<
+    index_id<Registry>, std::size_t(virtual_<const Base&>), Registry>;
+
+template<class Method>
+struct leaf_overriders {
+    template<class... N>
+    using fn = typename Method::template override<leaf_index<N>...>;
+};
+
+} // namespace
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(
+    vptr_flat_map_dispatch, Registry, registries<__COUNTER__>) {
+    using index = index_method<Registry>;
+
+    BOOST_OPENMETHOD_REGISTER(mp_apply<use_classes, leaf_classes<Registry>>);
+    BOOST_OPENMETHOD_REGISTER(
+        mp_apply_q<leaf_overriders<index>, mp_iota_c<leaves>>);
+
+    // The table is empty before `initialize`.
+    BOOST_CHECK_THROW(
+        Registry::vptr::dynamic_vptr(Leaf<mp_size_t<0>>()), missing_class);
+
+    initialize<Registry>();
+
+    mp_for_each<mp_iota_c<leaves>>([](auto n) {
+        Leaf<decltype(n)> leaf;
+        BOOST_TEST(index::fn(leaf) == n.value);
+    });
+
+    BOOST_CHECK_THROW(index::fn(Unregistered()), missing_class);
+
+    finalize<Registry>();
+
+    // ...and after `finalize`.
+    BOOST_CHECK_THROW(
+        Registry::vptr::dynamic_vptr(Leaf<mp_size_t<0>>()), missing_class);
+    BOOST_CHECK_THROW(index::fn(Leaf<mp_size_t<0>>()), not_initialized);
+}
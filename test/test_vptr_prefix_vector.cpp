@@ -0,0 +1,167 @@
+// Copyright (c) 2018-2025 Jean-Louis Leroy
+// Distributed under the Boost Software License, Version 1.0.
+// See accompanying file LICENSE_1_0.txt
+// or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <boost/openmethod.hpp>
+#include <boost/openmethod/policies/vptr_prefix_vector.hpp>
+#include <boost/openmethod/initialize.hpp>
+
+#include <string>
+
+#define BOOST_TEST_MODULE vptr_prefix_vector
+#include <boost/test/unit_test.hpp>
+
+#include "test_util.hpp"
+
+using namespace boost::openmethod;
+
+namespace {
+
+struct Animal {
+    virtual ~Animal() = default;
+};
+
+struct Pet {
+    virtual ~Pet() = default;
+    std::string owner = "Bill";
+};
+
+struct Dog : Animal, Pet {};
+struct Cat : Animal, Pet {};
+struct Cow : Animal {};
+
+auto kind_dog(const Dog&) -> std::string {
+    return "dog";
+}
+
+auto kind_cat(const Cat&) -> std::string {
+    return "cat";
+}
+
+auto kind_cow(const Cow&) -> std::string {
+    return "cow";
+}
+
+auto legs_animal(const Animal&) -> int {
+    return 4;
+}
+
+auto sound_dog(const Dog&) -> std::string {
+    return "bark";
+}
+
+auto sound_cat(const Cat&) -> std::string {
+    return "meow";
+}
+
+auto sound_cow(const Cow&) -> std::string {
+    return "moo";
+}
+
+auto owner_pet(const Pet& pet) -> std::string {
+    return pet.owner;
+}
+
+auto meet_animals(const Animal&, const Animal&) -> std::string {
+    return "ignore";
+}
+
+auto meet_dog_cat(const Dog&, const Cat&) -> std::string {
+    return "chase";
+}
+
+auto meet_cat_dog(const Cat&, const Dog&) -> std::string {
+    return "hiss";
+}
+
+struct kind_id;
+struct legs_id;
+struct sound_id;
+struct owner_id;
+struct meet_id;
+
+template<int N>
+struct direct_registry
+    : test_registry_<N, policies::vptr_prefix_vector<2>> {};
+
+template<int N>
+struct indirect_registry
+    : test_registry_<
+          N, policies::vptr_prefix_vector<2>, policies::indirect_vptr> {};
+
+template<int N>
+using registries = boost::mp11::mp_list<
+    direct_registry<N>, indirect_registry<N>,
+    test_registry_<N, policies::vptr_prefix_vector<>>>;
+
+} // namespace
+
+static_assert(
+    sizeof(policies::vptr_prefix_vector<>::fn<
+           default_registry>::bucket) == 8 * sizeof(void*));
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(
+    vptr_prefix_vector_dispatch, Registry, registries<__COUNTER__>) {
+    using kind =
+        method<kind_id, std::string(virtual_<const Animal&>), Registry>;
+    using legs = method<legs_id, int(virtual_<const Animal&>), Registry>;
+    using sound =
+        method<sound_id, std::string(virtual_<const Animal&>), Registry>;
+    using owner = method<owner_id, std::string(virtual_<const Pet&>), Registry>;
+    using meet = method<
+        meet_id,
+        std::string(virtual_<const Animal&>, virtual_<const Animal&>),
+        Registry>;
+
+    BOOST_OPENMETHOD_REGISTER(
+        use_classes<Animal, Pet, Dog, Cat, Cow, Registry>);
+    BOOST_OPENMETHOD_REGISTER(
+        typename kind::template override<kind_dog, kind_cat, kind_cow>);
+    BOOST_OPENMETHOD_REGISTER(typename legs::template override<legs_animal>);
+    BOOST_OPENMETHOD_REGISTER(
+        typename sound::template override<sound_dog, sound_cat, sound_cow>);
+    BOOST_OPENMETHOD_REGISTER(typename owner::template override<owner_pet>);
+    BOOST_OPENMETHOD_REGISTER(
+        typename meet::template override<
+            meet_animals, meet_dog_cat, meet_cat_dog>);
+
+    Dog dog;
+    Cat cat;
+    Cow cow;
+
+    // Initialize twice, to check that the buckets are rebuilt each time.
+    for (int i = 0; i < 2; ++i) {
+        auto comp = initialize<Registry>(retain_compiler());
+
+        BOOST_TEST(kind::fn(dog) == "dog");
+        BOOST_TEST(kind::fn(cat) == "cat");
+        BOOST_TEST(kind::fn(cow) == "cow");
+        BOOST_TEST(legs::fn(dog) == 4);
+        BOOST_TEST(legs::fn(cow) == 4);
+        BOOST_TEST(sound::fn(dog) == "bark");
+        BOOST_TEST(sound::fn(cat) == "meow");
+        BOOST_TEST(sound::fn(cow) == "moo");
+        BOOST_TEST(owner::fn(dog) == "Bill");
+        BOOST_TEST(owner::fn(cat) == "Bill");
+        BOOST_TEST(meet::fn(dog, cat) == "chase");
+        BOOST_TEST(meet::fn(cat, dog) == "hiss");
+        BOOST_TEST(meet::fn(cow, dog) == "ignore");
+
+        using vptr = typename Registry::vptr;
+
+        for (auto m : {comp[kind::fn], comp[legs::fn], comp[sound::fn]}) {
+            BOOST_TEST_REQUIRE(m != nullptr);
+            auto slot = m->slots[0];
+
+            for (const Animal* animal :
+                 std::initializer_list<const Animal*>{&dog, &cat, &cow}) {
+                BOOST_TEST(
+                    vptr::dynamic_slot(*animal, slot).pf ==
+                    vptr::dynamic_vptr(*animal)[slot].pf);
+            }
+        }
+    }
+
+    finalize<Registry>();
+}